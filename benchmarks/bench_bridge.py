@@ -0,0 +1,282 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+"""Headless benchmark for the bridge data path.
+
+Builds synthetic scenes over a parameter grid and times grouping, shm upload,
+engine compute and result application end to end.
+
+Usage:
+    blender -b --factory-startup --python benchmarks/bench_bridge.py -- \
+        [--grid quick|full] [--repeat N] [--output bench_output.json]
+
+Individual axes can be overridden with comma-separated lists, e.g.
+    ... -- --groups 10,100 --objects-per-group 1,50 --verts-per-object 1000 --depth 0,3
+
+Requires the pivot_lib package in Blender's site-packages (the
+blender_bridge_cython target installs a symlink) and the engine binary in
+pivot/bin. Results are written as JSON: one record per grid point with
+wall-clock stage timings in ms, the resident memory the point added, and the
+profiler summary when
+pivot_lib was built with PIVOT_PROFILING.
+"""
+
+import argparse
+import itertools
+import json
+import math
+import os
+import sys
+import time
+
+import bpy
+
+REPO_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+GRIDS = {
+    "quick": {
+        "groups": [10, 100],
+        "objects_per_group": [1, 20],
+        "verts_per_object": [400],
+        "depth": [0, 2],
+    },
+    "full": {
+        "groups": [10, 100, 1000],
+        "objects_per_group": [1, 20, 200],
+        "verts_per_object": [100, 2500, 40000],
+        "depth": [0, 2, 5],
+    },
+}
+
+# Grid points above this many vertices are skipped; they need more memory than CI has
+MAX_SCENE_VERTS = 50_000_000
+SYNC_TIMEOUT_S = 600.0
+
+
+def _parse_args():
+    argv = sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else []
+    parser = argparse.ArgumentParser(prog="bench_bridge.py")
+    parser.add_argument("--grid", choices=sorted(GRIDS), default="quick")
+    parser.add_argument("--groups", type=str)
+    parser.add_argument("--objects-per-group", type=str)
+    parser.add_argument("--verts-per-object", type=str)
+    parser.add_argument("--depth", type=str, help="Nested collection levels inside each group")
+    parser.add_argument("--repeat", type=int, default=3, help="Timed runs per grid point (best run is reported)")
+    parser.add_argument("--shared-meshes", action="store_true", help="Let objects of equal size share one mesh datablock")
+    parser.add_argument("--output", type=str, help="JSON output path (default: stdout)")
+    return parser.parse_args(argv)
+
+
+def _axis(args, name):
+    override = getattr(args, name)
+    if override:
+        return [int(v) for v in override.split(",") if v]
+    return GRIDS[args.grid][name]
+
+
+def _current_rss_mb():
+    """Resident set size right now; ru_maxrss would carry the peak of earlier points."""
+    try:
+        with open("/proc/self/statm", encoding="ascii") as f:
+            resident_pages = int(f.read().split()[1])
+    except (OSError, ValueError, IndexError):
+        return None
+    return resident_pages * os.sysconf("SC_PAGE_SIZE") / (1024 * 1024)
+
+
+# ---------------------------------------------------------------------------
+# Scene generation
+# ---------------------------------------------------------------------------
+
+def _grid_mesh(name, verts_per_object):
+    """Planar quad grid with roughly verts_per_object vertices."""
+    side = max(2, int(math.sqrt(verts_per_object)))
+    verts = [(x / side, y / side, 0.0) for y in range(side) for x in range(side)]
+    faces = [
+        (y * side + x, y * side + x + 1, (y + 1) * side + x + 1, (y + 1) * side + x)
+        for y in range(side - 1)
+        for x in range(side - 1)
+    ]
+    mesh = bpy.data.meshes.new(name)
+    mesh.from_pydata(verts, [], faces)
+    mesh.update()
+    return mesh
+
+
+def _clear_scene():
+    bpy.data.batch_remove(list(bpy.data.objects))
+    bpy.data.batch_remove(list(bpy.data.meshes))
+    bpy.data.batch_remove(list(bpy.data.collections))
+
+
+def build_scene(groups, objects_per_group, verts_per_object, depth, shared_meshes):
+    """Create `groups` top-level collections, each holding its objects spread over `depth` nested levels."""
+    _clear_scene()
+    scene = bpy.context.scene
+    root = scene.collection
+    template = _grid_mesh("bench_template", verts_per_object)
+
+    for g in range(groups):
+        group_col = bpy.data.collections.new(f"bench_group_{g}")
+        root.children.link(group_col)
+
+        levels = [group_col]
+        for d in range(depth):
+            child = bpy.data.collections.new(f"bench_group_{g}_l{d}")
+            levels[-1].children.link(child)
+            levels.append(child)
+
+        for o in range(objects_per_group):
+            mesh = template if shared_meshes else template.copy()
+            obj = bpy.data.objects.new(f"bench_{g}_{o}", mesh)
+            obj.location = (g * 2.0, o * 2.0, 0.0)
+            obj.rotation_euler = (0.0, 0.0, 0.1 * o)
+            levels[o % len(levels)].objects.link(obj)
+
+    scene.pivot.objects_collection = None
+    bpy.context.view_layer.update()
+    for obj in bpy.data.objects:
+        obj.select_set(True)
+    return list(bpy.context.selected_objects)
+
+
+# ---------------------------------------------------------------------------
+# Measurement
+# ---------------------------------------------------------------------------
+
+def _drain_sync(mesh_sync, jobs):
+    """Drive the sync timer by hand until every job's results are applied."""
+    deadline = time.perf_counter() + SYNC_TIMEOUT_S
+    while any(not job.done() for job in jobs):
+        if time.perf_counter() > deadline:
+            raise TimeoutError("engine results did not arrive in time")
+        interval = mesh_sync.sync_timer_callback()
+        if interval:
+            time.sleep(min(interval, 0.01))
+
+
+def run_point(point, shared_meshes, repeat):
+    from pivot_lib import selection_utils, shm_utils, standardize, id_manager, profiler, job_queue
+    from pivot import mesh_sync
+
+    verts_total = point["groups"] * point["objects_per_group"] * point["verts_per_object"]
+    record = dict(point, scene_verts=verts_total)
+    if verts_total > MAX_SCENE_VERTS:
+        record["skipped"] = "scene too large"
+        return record
+
+    rss_before = _current_rss_mb()
+    t = time.perf_counter()
+    selection = build_scene(shared_meshes=shared_meshes, **point)
+    record["build_scene_ms"] = (time.perf_counter() - t) * 1000
+
+    # The first aggregate relinks root objects; after that grouping is stable across runs
+    selection_utils.aggregate_object_groups(selection)
+
+    best = None
+    for _ in range(repeat):
+        id_manager.reset_state()
+        profiler.reset()
+        run = {}
+
+        t = time.perf_counter()
+        mesh_groups, group_names, collections = selection_utils.aggregate_object_groups(selection)
+        run["aggregate_object_groups_ms"] = (time.perf_counter() - t) * 1000
+
+        asset_uuids = id_manager.get_or_create_asset_uuid(collections)
+        surface_contexts = standardize._build_group_surface_contexts(asset_uuids, "AUTO")
+        t = time.perf_counter()
+        context = shm_utils.create_data_arrays(mesh_groups, group_names, asset_uuids, surface_contexts)
+        run["create_data_arrays_ms"] = (time.perf_counter() - t) * 1000
+        # Hand the context to the engine like the real path so its shm is released
+        _drain_sync(mesh_sync, [job_queue.submit(context, True, asset_uuids)])
+        del context
+
+        # End to end: upload, engine compute, then apply through the sync timer
+        id_manager.reset_state()
+        t = time.perf_counter()
+        jobs = standardize.standardize_groups(selection, "BASE", "AUTO", False)
+        run["standardize_groups_ms"] = (time.perf_counter() - t) * 1000
+
+        t = time.perf_counter()
+        _drain_sync(mesh_sync, jobs)
+        run["sync_apply_ms"] = (time.perf_counter() - t) * 1000
+        run["end_to_end_ms"] = run["standardize_groups_ms"] + run["sync_apply_ms"]
+
+        if profiler.enabled():
+            run["stages"] = profiler.summary()
+
+        if best is None or run["end_to_end_ms"] < best["end_to_end_ms"]:
+            best = run
+
+    record.update(best)
+    rss_after = _current_rss_mb()
+    record["rss_delta_mb"] = rss_after - rss_before if rss_before is not None and rss_after is not None else None
+    return record
+
+
+def _register_addon():
+    if REPO_ROOT not in sys.path:
+        sys.path.insert(0, REPO_ROOT)
+    import pivot
+    pivot.register()
+    return pivot
+
+
+def main():
+    args = _parse_args()
+    pivot = _register_addon()
+
+    from pivot import mesh_sync
+    from pivot_lib import edition_utils, profiler
+
+    # Apply whole contexts per tick so sync_apply_ms measures the apply work, not the budget
+    mesh_sync.set_apply_budget_ms(0)
+
+    axes = ("groups", "objects_per_group", "verts_per_object", "depth")
+    points = [dict(zip(axes, values)) for values in itertools.product(*(_axis(args, a) for a in axes))]
+
+    results = []
+    try:
+        for point in points:
+            if not edition_utils.is_pro_edition() and point["groups"] * point["objects_per_group"] != 1:
+                continue
+            print(f"[Pivot] bench {point}")
+            results.append(run_point(point, args.shared_meshes, args.repeat))
+    finally:
+        pivot.unregister()
+
+    report = {
+        "blender": bpy.app.version_string,
+        "edition": "PRO" if edition_utils.is_pro_edition() else "STANDARD",
+        "profiling": profiler.enabled(),
+        "grid": args.grid,
+        "repeat": args.repeat,
+        "shared_meshes": args.shared_meshes,
+        "results": results,
+    }
+    text = json.dumps(report, indent=2)
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            f.write(text)
+        print(f"[Pivot] Wrote benchmark results to {args.output}")
+    else:
+        print(text)
+
+
+if __name__ == "__main__":
+    main()
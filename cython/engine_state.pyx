@@ -25,6 +25,9 @@ about how Blender-side edits diverge from the engine.
 # Flag to indicate if classification is in progress
 cdef bint _is_performing_classification = False
 
+# Number of finalize calls whose results have not come back through poll_mesh_sync yet
+cdef int _pending_sync_count = 0
+
 # ---------------------------------------------------------------------------
 # Classification flag helpers
 # ---------------------------------------------------------------------------
@@ -39,3 +42,31 @@ def is_performing_classification() -> bint:
     """Check if classification is currently in progress."""
     return _is_performing_classification
 
+
+
+# ---------------------------------------------------------------------------
+# Outstanding engine results
+# ---------------------------------------------------------------------------
+
+def begin_pending_sync() -> None:
+    """Record that a finalize was submitted and its results are still in flight."""
+    global _pending_sync_count
+    _pending_sync_count += 1
+
+
+def end_pending_sync() -> None:
+    """Record that one batch of results arrived (or that a finalize failed)."""
+    global _pending_sync_count
+    if _pending_sync_count > 0:
+        _pending_sync_count -= 1
+
+
+def has_pending_sync() -> bint:
+    """Check whether the sync timer should keep polling the engine quickly."""
+    return _pending_sync_count > 0
+
+
+def clear_pending_sync() -> None:
+    """Forget all outstanding results, e.g. when the engine is restarted."""
+    global _pending_sync_count
+    _pending_sync_count = 0
@@ -17,94 +17,300 @@
 
 import elbo_sdk_rust as engine
 import bpy
-
-# Reverse cache: bytes(16) -> [Python Object Reference, state flag]
-# This enables O(1) lookup during mesh sync with per-object state tracking
-# Using mutable lists to allow in-place flag updates without tuple recreation
-# Separate caches for objects and collections
-obj_uuid_cache = {}  # uuid -> [obj]
-col_uuid_cache = {}  # uuid -> [collection, bool_flag]
-membership_cache = {} # asset uuid -> [obj uuids...]
-parent_cache = {} # object uuid -> asset uuid
+import mathutils
+from libc.math cimport fabsf
+from cython.operator cimport dereference as deref
+from libc.stdint cimport int32_t, uint8_t, uint32_t, uint64_t
+from libc.string cimport memcpy
+from libcpp.unordered_map cimport unordered_map
+from libcpp.vector cimport vector
+from . import transform_utils
+
+cdef extern from "uuid_table.h" namespace "pivot_bridge":
+    cdef struct Uuid128:
+        unsigned char data[16]
+
+    cdef cppclass UuidTable:
+        int32_t find(const unsigned char* key)
+        void insert(const unsigned char* key, int32_t value)
+        bint erase(const unsigned char* key)
+        void clear()
+        size_t size()
+
+    cdef cppclass CsrLists:
+        void ensure_rows(size_t rows)
+        uint32_t row_size(size_t row)
+        const int32_t* row_data(size_t row)
+        void assign(size_t row, const int32_t* values, size_t count)
+        void append(size_t row, int32_t value)
+        bint remove(size_t row, int32_t value)
+        void clear_row(size_t row)
+        void clear()
+
+# Largest per-element difference that still counts as "did not move"
+TRANSFORM_EPSILON = 1e-6
+
+# Records live in slot-indexed arrays; UuidTable maps a raw 16-byte UUID to
+# its slot, so lookups from shm views never build a bytes key. Python object
+# references stay in parallel lists (None marks a free slot).
+#
+# Objects: uuid -> slot, with the object, its session_uid and its parent assets
+cdef UuidTable _obj_table
+cdef vector[Uuid128] _obj_uuids
+cdef vector[uint32_t] _obj_session_uids
+cdef list _obj_refs = []
+cdef vector[int32_t] _obj_free
+cdef CsrLists _obj_parents          # object slot -> asset slots
+cdef vector[uint32_t] _obj_revisions  # bumped on every geometry change seen by the handlers
+
+# Assets: uuid -> slot, with the collection, flags and member objects
+cdef UuidTable _col_table
+cdef vector[Uuid128] _col_uuids
+cdef vector[uint8_t] _col_flags
+cdef list _col_refs = []
+cdef list _col_signatures = []      # geometry signature of the last upload
+cdef vector[uint64_t] _col_revisions  # member revision stamp of the last upload
+cdef vector[int32_t] _col_free
+cdef CsrLists _col_members          # asset slot -> object slots
+
+cdef uint8_t FLAG_SYNCED = 1
+cdef uint8_t FLAG_HAS_MEMBERS = 2
+
+cdef uint64_t NO_REVISION = <uint64_t>-1
+
+# Object session_uid -> object slot, so repeated uploads resolve UUIDs without
+# an ID-property read or a bytes allocation per object
+cdef unordered_map[uint32_t, int32_t] _session_slot_map
 
 PIVOT_ASSET_ID = "pivot_asset_id"
 PIVOT_OBJECT_ID = "pivot_id"
 
+
+cdef inline const unsigned char* _key(bytes uuid) except NULL:
+    if len(uuid) != 16:
+        raise ValueError(f"pivot uuid must be 16 bytes but got {len(uuid)}")
+    return <const unsigned char*>uuid
+
+
+cdef int _check_uuid_view(const unsigned char[:, :] view) except -1:
+    if view.shape[0] and view.shape[1] != 16:
+        raise ValueError(f"uuid view rows must be 16 bytes but got {view.shape[1]}")
+    return 0
+
+
+cdef inline void _load_row(const unsigned char[:, :] view, Py_ssize_t i, unsigned char* out):
+    cdef Py_ssize_t j
+    for j in range(16):
+        out[j] = view[i, j]
+
+
+cdef inline bytes _uuid_bytes(const Uuid128* uuid):
+    return (<const char*>uuid.data)[:16]
+
+
+cdef int32_t _obj_slot(bytes uuid) except -2:
+    if uuid is None or len(uuid) != 16:
+        return -1
+    return _obj_table.find(<const unsigned char*>uuid)
+
+
+cdef int32_t _col_slot(bytes uuid) except -2:
+    if uuid is None or len(uuid) != 16:
+        return -1
+    return _col_table.find(<const unsigned char*>uuid)
+
+
+cdef int32_t _alloc_obj(const unsigned char* key, obj, uint32_t session_uid):
+    cdef int32_t slot
+    cdef Uuid128 uuid
+    memcpy(uuid.data, key, 16)
+    if not _obj_free.empty():
+        slot = _obj_free.back()
+        _obj_free.pop_back()
+        _obj_uuids[slot] = uuid
+        _obj_session_uids[slot] = session_uid
+        _obj_refs[slot] = obj
+        _obj_revisions[slot] = 0
+    else:
+        slot = <int32_t>_obj_uuids.size()
+        _obj_uuids.push_back(uuid)
+        _obj_session_uids.push_back(session_uid)
+        _obj_refs.append(obj)
+        _obj_revisions.push_back(0)
+        _obj_parents.ensure_rows(slot + 1)
+    _obj_parents.clear_row(slot)
+    _obj_table.insert(key, slot)
+    return slot
+
+
+cdef int32_t _alloc_col(const unsigned char* key, col):
+    cdef int32_t slot
+    cdef Uuid128 uuid
+    memcpy(uuid.data, key, 16)
+    if not _col_free.empty():
+        slot = _col_free.back()
+        _col_free.pop_back()
+        _col_uuids[slot] = uuid
+        _col_flags[slot] = 0
+        _col_refs[slot] = col
+        _col_signatures[slot] = None
+        _col_revisions[slot] = NO_REVISION
+    else:
+        slot = <int32_t>_col_uuids.size()
+        _col_uuids.push_back(uuid)
+        _col_flags.push_back(0)
+        _col_refs.append(col)
+        _col_signatures.append(None)
+        _col_revisions.push_back(NO_REVISION)
+        _col_members.ensure_rows(slot + 1)
+    _col_members.clear_row(slot)
+    _col_table.insert(key, slot)
+    return slot
+
+
+cdef void _free_obj(int32_t slot):
+    _session_slot_map.erase(_obj_session_uids[slot])
+    _obj_table.erase(_obj_uuids[slot].data)
+    _obj_parents.clear_row(slot)
+    _obj_refs[slot] = None
+    _obj_free.push_back(slot)
+
+
+cdef void _free_col(int32_t slot):
+    _col_table.erase(_col_uuids[slot].data)
+    _col_members.clear_row(slot)
+    _col_flags[slot] = 0
+    _col_refs[slot] = None
+    _col_signatures[slot] = None
+    _col_revisions[slot] = NO_REVISION
+    _col_free.push_back(slot)
+
+
+cdef list _member_slots(int32_t col_slot):
+    cdef uint32_t n = _col_members.row_size(col_slot)
+    cdef const int32_t* data = _col_members.row_data(col_slot)
+    return [data[i] for i in range(n)]
+
+
+cdef uint64_t _revision_stamp(int32_t col_slot):
+    """Sum of member revisions; counters only grow, so any bump changes it."""
+    cdef uint32_t n = _col_members.row_size(col_slot)
+    cdef const int32_t* data = _col_members.row_data(col_slot) if n else NULL
+    cdef uint64_t stamp = n
+    cdef uint32_t i
+    for i in range(n):
+        stamp += _obj_revisions[data[i]]
+    return stamp
+
+
 def get_objects_collection() -> Optional[Any]:
         """Get the objects collection from the scene's pivot properties."""
         objects_collection = bpy.context.scene.pivot.objects_collection
         return objects_collection if objects_collection else bpy.context.scene.collection
 
-def drop_assets(list uuids):
+def drop_assets(list uuids) -> list:
+    """Forget assets; returns the session_uids of member objects no longer tracked."""
+    cdef int32_t col_slot
+    cdef int32_t obj_slot
+    cdef list released = []
     for uuid in uuids:
-        if uuid in col_uuid_cache and uuid in membership_cache:
-            col_uuid_cache[uuid][0].color_tag = 'NONE'
-
-            obj_uuids = membership_cache[uuid]
-            _drop_objects(obj_uuids)
-            del col_uuid_cache[uuid]
-            del membership_cache[uuid]
+        col_slot = _col_slot(uuid)
+        if col_slot >= 0 and _col_flags[col_slot] & FLAG_HAS_MEMBERS:
+            _col_refs[col_slot].color_tag = 'NONE'
+
+            for obj_slot in _member_slots(col_slot):
+                _obj_parents.remove(obj_slot, col_slot)
+                # Objects shared with another asset stay tracked for it
+                if _obj_parents.row_size(obj_slot) == 0:
+                    released.append(_obj_session_uids[obj_slot])
+                    _free_obj(obj_slot)
+            _free_col(col_slot)
         else:
             print("Tried to drop asset: ", uuid, ", but did not exist in both asset caches")
-
-def _drop_objects(list uuids):
-    for uuid in uuids:
-        if uuid in obj_uuid_cache and uuid in parent_cache:
-            del obj_uuid_cache[uuid]
-            del parent_cache[uuid]
-        else:
-            print("Tried to drop object: ", uuid, ", but did not exist in both object caches")
+    return released
 
 
-def set_asset_membership(bytes asset_uuid, unsigned char[:, :] obj_uuids):
+def set_asset_membership(bytes asset_uuid, const unsigned char[:, :] obj_uuids):
     cdef Py_ssize_t num_uuids = obj_uuids.shape[0]
-
     cdef Py_ssize_t i
+    cdef int32_t col_slot = _col_slot(asset_uuid)
+    cdef int32_t obj_slot
+    cdef Uuid128 key
+    cdef vector[int32_t] members
 
-    # Since we are reseting the asset membership cache we must also remove that asset from the its previous objects' parent caches
-    # Should be cheap as usually there is only one member anyways
-    if asset_uuid in membership_cache:
-        prev_members = membership_cache[asset_uuid]
-        for mem in prev_members:
-            parent_cache[mem].remove(asset_uuid)
+    if col_slot < 0:
+        print(f"[Pivot Error] Membership set on missing asset UUID: {asset_uuid}")
+        return
+    _check_uuid_view(obj_uuids)
 
-    # Reset that asset's membership cache
-    membership_cache[asset_uuid] = []
+    # Since we are reseting the asset membership we must also remove that asset from its previous objects' parents
+    # Should be cheap as usually there is only one member anyways
+    for obj_slot in _member_slots(col_slot):
+        _obj_parents.remove(obj_slot, col_slot)
 
-    # Add the uuids to the new membership cache and the asset to their parent caches
+    members.reserve(num_uuids)
     for i in range(num_uuids):
-        uuid_bytes = bytes(obj_uuids[i])
-        membership_cache[asset_uuid].append(uuid_bytes)
-        parent_cache.setdefault(uuid_bytes, []).append(asset_uuid)
+        _load_row(obj_uuids, i, key.data)
+        obj_slot = _obj_table.find(key.data)
+        if obj_slot < 0:
+            continue
+        members.push_back(obj_slot)
+        _obj_parents.append(obj_slot, col_slot)
+
+    _col_members.assign(col_slot, members.data(), members.size())
+    _col_flags[col_slot] = _col_flags[col_slot] | FLAG_HAS_MEMBERS
 
 def get_asset_members(bytes uuid):
-    return membership_cache[uuid]
+    cdef int32_t col_slot = _col_slot(uuid)
+    if col_slot < 0 or not (_col_flags[col_slot] & FLAG_HAS_MEMBERS):
+        raise KeyError(uuid)
+    return [_uuid_bytes(&_obj_uuids[obj_slot]) for obj_slot in _member_slots(col_slot)]
 
 def get_obj_asset(bytes uuid):
-    return parent_cache[uuid]
+    cdef int32_t obj_slot = _obj_slot(uuid)
+    if obj_slot < 0:
+        raise KeyError(uuid)
+    cdef uint32_t n = _obj_parents.row_size(obj_slot)
+    cdef const int32_t* data = _obj_parents.row_data(obj_slot)
+    return [_uuid_bytes(&_col_uuids[data[i]]) for i in range(n)]
 
 def get_all_asset_uuids():
-    return col_uuid_cache.keys()
+    return [_uuid_bytes(&_col_uuids[i]) for i in range(_col_uuids.size()) if _col_refs[i] is not None]
 
 def get_all_obj_uuids():
-    return obj_uuid_cache.keys()
+    return [_uuid_bytes(&_obj_uuids[i]) for i in range(_obj_uuids.size()) if _obj_refs[i] is not None]
 
 def reset_state():
-    for uuid in col_uuid_cache:
-        entry =  col_uuid_cache[uuid]
-        entry[0].color_tag = 'NONE'
-    col_uuid_cache.clear()
-    obj_uuid_cache.clear()
-    membership_cache.clear()
-    parent_cache.clear()
+    for col in _col_refs:
+        if col is not None:
+            col.color_tag = 'NONE'
+    _obj_table.clear()
+    _obj_uuids.clear()
+    _obj_session_uids.clear()
+    _obj_refs.clear()
+    _obj_free.clear()
+    _obj_parents.clear()
+    _obj_revisions.clear()
+    _col_table.clear()
+    _col_uuids.clear()
+    _col_flags.clear()
+    _col_refs.clear()
+    _col_signatures.clear()
+    _col_revisions.clear()
+    _col_free.clear()
+    _col_members.clear()
+    _session_slot_map.clear()
 
 def has_assets():
-    return bool(col_uuid_cache)
+    return _col_table.size() > 0
 
 def has_asset(bytes uuid):
-    return uuid in col_uuid_cache
+    return _col_slot(uuid) >= 0
 
-def _get_or_create_uuid(obj, prop_name, cache):
+def has_obj(bytes uuid):
+    return _obj_slot(uuid) >= 0
+
+def _get_or_create_uuid(obj, prop_name):
     """Helper function to get or create UUID for object or collection."""
 
     if prop_name not in obj:
@@ -115,65 +321,286 @@ def _get_or_create_uuid(obj, prop_name, cache):
         uuid_bytes = bytes(uuid_bytes)
     return uuid_bytes
 
+cdef bytes _register_obj(obj, Uuid128* out):
+    """Resolve an object's UUID, record it in the object table and copy it to out."""
+    cdef uint32_t session_uid = obj.session_uid
+    cdef bytes uuid_bytes = _get_or_create_uuid(obj, PIVOT_OBJECT_ID)
+    cdef const unsigned char* key = _key(uuid_bytes)
+    cdef int32_t slot = _obj_table.find(key)
+    if slot < 0:
+        slot = _alloc_obj(key, obj, session_uid)
+    else:
+        if _obj_session_uids[slot] != session_uid:
+            _session_slot_map.erase(_obj_session_uids[slot])
+            _obj_session_uids[slot] = session_uid
+        _obj_refs[slot] = obj
+    memcpy(out.data, key, 16)
+    _session_slot_map[session_uid] = slot
+    return uuid_bytes
+
 def get_or_create_obj_uuids(list objs):
     cdef list uuids = []
+    cdef Uuid128 value
     for obj in objs:
-        uuid_bytes = _get_or_create_uuid(obj, PIVOT_OBJECT_ID, obj_uuid_cache)
-        obj_uuid_cache[uuid_bytes] = [obj]
-        uuids.append(uuid_bytes)
+        uuids.append(_register_obj(obj, &value))
     return uuids
 
+def fill_obj_uuids(list objs, unsigned char[::1] out):
+    """Write the UUID of every (original) object into out, 16 bytes per object.
+
+    Objects seen before are resolved through the session_uid map without
+    touching their ID properties. out is typically the group's uuids shm buffer.
+    """
+    cdef Py_ssize_t num_objs = len(objs)
+    cdef Py_ssize_t i
+    cdef uint32_t session_uid
+    cdef Uuid128 value
+    cdef unordered_map[uint32_t, int32_t].iterator it
+
+    if out.shape[0] < num_objs * 16:
+        raise ValueError(f"uuid buffer holds {out.shape[0] // 16} uuids but {num_objs} objects were given")
+
+    for i in range(num_objs):
+        obj = objs[i]
+        session_uid = obj.session_uid
+        it = _session_slot_map.find(session_uid)
+        if it != _session_slot_map.end():
+            memcpy(&out[i * 16], _obj_uuids[deref(it).second].data, 16)
+            # Undo and file reloads hand out new ID wrappers; keep the ref current
+            _obj_refs[deref(it).second] = obj
+        else:
+            _register_obj(obj, &value)
+            memcpy(&out[i * 16], value.data, 16)
+
 def get_or_create_asset_uuid(list cols):
     cdef list uuids = []
+    cdef int32_t slot
     for col in cols:
-        uuid_bytes = _get_or_create_uuid(col, PIVOT_ASSET_ID, col_uuid_cache)
-        col_uuid_cache[uuid_bytes] = [col, False]
+        uuid_bytes = _get_or_create_uuid(col, PIVOT_ASSET_ID)
+        slot = _col_table.find(_key(uuid_bytes))
+        if slot < 0:
+            _alloc_col(<const unsigned char*>uuid_bytes, col)
+        else:
+            # Keep the sync flag so already-synced assets can be skipped on re-upload
+            _col_refs[slot] = col
         uuids.append(uuid_bytes)
     return uuids
 
 def get_obj_by_uuid(list uuids):
     """Pure function to get UUID for object without creating it if it doesn't exist."""
     cdef list objs = []
+    cdef int32_t slot
     for uuid in uuids:
-        entry = obj_uuid_cache[uuid]
-        objs.append(entry[0])
-    return objs  # Return just the object, not the flag
+        slot = _obj_slot(uuid)
+        if slot < 0:
+            raise KeyError(uuid)
+        objs.append(_obj_refs[slot])
+    return objs
+
+def apply_transforms_batch(const unsigned char[:, :] uuids, const float[::1] transforms, float epsilon=TRANSFORM_EPSILON):
+    """Apply column-major world matrices (16 floats per UUID) returned by the engine.
+
+    Current matrices are read in bulk and compared in C; only objects whose
+    matrix actually changed are written and tagged. Returns the number moved.
+    """
+    cdef Py_ssize_t num_uuids = uuids.shape[0]
+    cdef Py_ssize_t i
+    cdef Py_ssize_t j
+    cdef Py_ssize_t moved = 0
+    cdef list objs = []
+    cdef vector[Py_ssize_t] slots
+    cdef const float* target
+    cdef const float* current
+    cdef Uuid128 key
+    cdef int32_t obj_slot
+
+    if transforms.shape[0] < num_uuids * 16:
+        raise ValueError(f"transform buffer holds {transforms.shape[0] // 16} matrices but {num_uuids} uuids were given")
+    _check_uuid_view(uuids)
+
+    for i in range(num_uuids):
+        _load_row(uuids, i, key.data)
+        obj_slot = _obj_table.find(key.data)
+        if obj_slot >= 0:
+            objs.append(_obj_refs[obj_slot])
+            slots.push_back(i)
+
+    cdef Py_ssize_t num_objs = len(objs)
+    if num_objs == 0:
+        return 0
+
+    cdef float[::1] current_mv = transform_utils.scratch_floats(num_objs * 16)
+    current_mv = current_mv[:num_objs * 16]
+    snapshot = transform_utils.SceneTransforms() if transform_utils.should_bulk_read(num_objs) else None
+    transform_utils.read_matrices(objs, current_mv, snapshot)
+
+    for i in range(num_objs):
+        target = &transforms[slots[i] * 16]
+        current = &current_mv[i * 16]
+        for j in range(16):
+            if fabsf(target[j] - current[j]) > epsilon:
+                break
+        else:
+            continue
+
+        # Column-major in shm; mathutils wants rows
+        obj = objs[i]
+        obj.matrix_world = mathutils.Matrix((
+            (target[0], target[4], target[8], target[12]),
+            (target[1], target[5], target[9], target[13]),
+            (target[2], target[6], target[10], target[14]),
+            (target[3], target[7], target[11], target[15]),
+        ))
+        obj.data.update()
+        obj.update_tag()
+        moved += 1
+
+    return moved
+
+def get_assets_from_view(const unsigned char[:, :] uuids) -> list:
+    """Resolve a uint8[N, 16] uuid view to collections; raises KeyError for unknown assets."""
+    cdef Py_ssize_t num_uuids = uuids.shape[0]
+    cdef Py_ssize_t i
+    cdef Uuid128 key
+    cdef int32_t slot
+    cdef list cols = [None] * num_uuids
+
+    _check_uuid_view(uuids)
+    for i in range(num_uuids):
+        _load_row(uuids, i, key.data)
+        slot = _col_table.find(key.data)
+        if slot < 0:
+            raise KeyError(_uuid_bytes(&key))
+        cols[i] = _col_refs[slot]
+    return cols
+
+def apply_group_sync(const unsigned char[:, :] asset_uuids, Py_ssize_t group_index, const unsigned char[:, :] obj_uuids, const float[::1] transforms) -> int:
+    """Apply one group of a sync context: membership, transforms, then mark it synced.
+
+    Takes the context's asset uuid view and the group's object uuid view as
+    they come from shm. An asset whose members changed revision since they
+    were uploaded stays unsynced, since the results describe the old geometry.
+    Returns the number of objects moved.
+    """
+    _check_uuid_view(asset_uuids)
+    if group_index < 0 or group_index >= asset_uuids.shape[0]:
+        raise IndexError(f"group {group_index} out of range for {asset_uuids.shape[0]} assets")
+
+    cdef Uuid128 key
+    _load_row(asset_uuids, group_index, key.data)
+    cdef bytes asset_uuid = _uuid_bytes(&key)
+    cdef int32_t slot = _col_table.find(key.data)
+    if slot < 0:
+        print(f"[Pivot Error] Sync results for missing asset UUID: {asset_uuid}")
+        return 0
+
+    set_asset_membership(asset_uuid, obj_uuids)
+    moved = apply_transforms_batch(obj_uuids, transforms)
+    _set_sync_slot(slot, _col_revisions[slot] == NO_REVISION or _col_revisions[slot] == _revision_stamp(slot))
+    return moved
 
 def get_asset_by_uuid(list uuids):
     """Pure function to get collections by UUIDs without creating them."""
     cdef list cols = []
+    cdef int32_t slot
     for uuid in uuids:
-        entry = col_uuid_cache[uuid]
-        cols.append(entry[0])  # Return just the collection
+        slot = _col_slot(uuid)
+        if slot < 0:
+            raise KeyError(uuid)
+        cols.append(_col_refs[slot])  # Return just the collection
     return cols
 
 
+def is_synced(bytes uuid):
+    """Check whether the engine holds up-to-date results for an asset."""
+    cdef int32_t slot = _col_slot(uuid)
+    return slot >= 0 and (_col_flags[slot] & FLAG_SYNCED) != 0
+
+cdef uint64_t _objs_revision_stamp(list objs):
+    """_revision_stamp for the (original) objects about to be uploaded as an asset."""
+    cdef uint64_t stamp = len(objs)
+    cdef Uuid128 value
+    cdef unordered_map[uint32_t, int32_t].iterator it
+    for obj in objs:
+        it = _session_slot_map.find(<uint32_t>obj.session_uid)
+        if it == _session_slot_map.end():
+            _register_obj(obj, &value)
+            it = _session_slot_map.find(<uint32_t>obj.session_uid)
+        stamp += _obj_revisions[deref(it).second]
+    return stamp
+
+def set_upload_signature(bytes uuid, tuple signature, list objs):
+    """Remember the geometry signature and member revisions an asset is uploaded with.
+
+    objs are the original objects written for the asset. Their revisions are
+    stamped at submit time because membership is only recorded once the
+    engine's results are applied.
+    """
+    cdef int32_t slot = _col_slot(uuid)
+    if slot >= 0:
+        _col_signatures[slot] = signature
+        _col_revisions[slot] = _objs_revision_stamp(objs)
+
+def get_upload_signature(bytes uuid):
+    cdef int32_t slot = _col_slot(uuid)
+    return _col_signatures[slot] if slot >= 0 else None
+
+def bump_obj_revisions(list uuids) -> None:
+    """Record a geometry change for each tracked object uuid (others are ignored)."""
+    cdef int32_t slot
+    for uuid in uuids:
+        slot = _obj_slot(uuid)
+        if slot >= 0:
+            _obj_revisions[slot] += 1
+
+def is_asset_current(bytes uuid) -> bool:
+    """Whether an asset is synced and no member changed geometry since its last upload.
+
+    Answered from counters alone, so callers can skip a group before evaluating it.
+    """
+    cdef int32_t slot = _col_slot(uuid)
+    if slot < 0 or not (_col_flags[slot] & FLAG_SYNCED) or _col_revisions[slot] == NO_REVISION:
+        return False
+    return _col_revisions[slot] == _revision_stamp(slot)
+
+cdef int _set_sync_slot(int32_t slot, bint value) except -1:
+    cdef bint current = (_col_flags[slot] & FLAG_SYNCED) != 0
+    if current == value:
+        return 0
+
+    col = _col_refs[slot]
+    if value:
+        col.color_tag = 'COLOR_04'  # Green
+        _col_flags[slot] = _col_flags[slot] | FLAG_SYNCED
+    else:
+        col.color_tag = 'COLOR_03'  # Yellow
+        _col_flags[slot] = _col_flags[slot] & <uint8_t>~FLAG_SYNCED
+    return 0
+
 # Functions to set the sync for UUIDS
 def set_sync(bytes uuid, bint value):
     """Update the boolean flag for a collection's UUID."""
-    entry = col_uuid_cache.get(uuid)
+    cdef int32_t slot = _col_slot(uuid)
     
-    if entry is not None:
-        if entry[1] != value:
-            col = entry[0]
-            
-            if value:
-                col.color_tag = 'COLOR_04'  # Green
-            else:
-                col.color_tag = 'COLOR_03'  # Yellow
-                
-            entry[1] = value
-            
+    if slot >= 0:
+        _set_sync_slot(slot, value)
     else:
         print(f"[Pivot Error] Sync called on missing UUID: {uuid}")
 
-def set_sync_batch(unsigned char[:, :] asset_uuids, bint value):
+def set_sync_batch(const unsigned char[:, :] asset_uuids, bint value):
     cdef Py_ssize_t num_uuids = asset_uuids.shape[0]
     cdef Py_ssize_t i
+    cdef Uuid128 key
+    cdef int32_t slot
 
+    _check_uuid_view(asset_uuids)
     for i in range(num_uuids):
-        uuid_bytes = bytes(asset_uuids[i])
-        set_sync(uuid_bytes, value)
+        _load_row(asset_uuids, i, key.data)
+        slot = _col_table.find(key.data)
+        if slot >= 0:
+            _set_sync_slot(slot, value)
+        else:
+            print(f"[Pivot Error] Sync called on missing UUID: {_uuid_bytes(&key)}")
 
 
 def get_asset_uuids_from_view(unsigned char[:] asset_uuids):
@@ -191,10 +618,16 @@ def get_asset_uuids_from_view(unsigned char[:] asset_uuids):
     cdef Py_ssize_t num_uuids = len(asset_uuids) // 16
     cdef list cols = []
     cdef Py_ssize_t i
+    cdef Py_ssize_t j
+    cdef Uuid128 key
+    cdef int32_t slot
     
     for i in range(num_uuids):
-        uuid_bytes = bytes(asset_uuids[i*16:(i+1)*16])
-        cols.append(col_uuid_cache[uuid_bytes][0])
+        for j in range(16):
+            key.data[j] = asset_uuids[i * 16 + j]
+        slot = _col_table.find(key.data)
+        if slot < 0:
+            raise KeyError(_uuid_bytes(&key))
+        cols.append(_col_refs[slot])
     
     return cols
-
@@ -0,0 +1,231 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+"""Asynchronous engine jobs.
+
+Responsibilities:
+- Run context.finalize() for prepared shm contexts on a worker thread, in submission order
+- Hand out job handles with progress queries and cancellation
+- Match results arriving through poll_mesh_sync back to the job that produced them
+
+Everything that touches bpy (filling shm, applying results) stays on the main
+thread; the worker only waits on the engine.
+"""
+
+import threading
+from collections import deque
+
+from . import engine_state, profiler
+
+JOB_QUEUED = "QUEUED"
+JOB_RUNNING = "RUNNING"
+JOB_AWAITING_RESULTS = "AWAITING_RESULTS"
+JOB_APPLYING = "APPLYING"
+JOB_DONE = "DONE"
+JOB_FAILED = "FAILED"
+JOB_CANCELLED = "CANCELLED"
+
+cdef object _lock = threading.Lock()
+cdef object _wakeup = threading.Condition(_lock)
+cdef object _queue = deque()
+cdef object _worker = None
+cdef object _running_job = None
+
+# Group uuid set of a submitted context -> jobs waiting on its results (FIFO).
+# Jobs cancelled after reaching the engine stay here so their results are
+# recognised (and dropped) when they arrive.
+cdef dict _awaiting = {}
+
+# Bumped by cancel_all; results of jobs submitted before the bump are dropped
+cdef unsigned long long _generation = 0
+
+# Engine compute as seen from the bridge, recorded on the worker thread
+cdef int STAGE_FINALIZE = profiler.stage_id("engine.finalize")
+
+
+class StandardizeJob:
+    """Handle for one finalize call and the results it streams back."""
+
+    def __init__(self, context, bint finalize_flag, list group_uuids):
+        self._context = context
+        self._finalize_flag = finalize_flag
+        self.group_uuids = group_uuids
+        self._key = frozenset(group_uuids)
+        self.group_count = len(group_uuids)
+        self.applied_groups = 0
+        self.state = JOB_QUEUED
+        self.error = None
+        self._cancelled = False
+        self._finalized = threading.Event()
+        self.generation = _generation
+
+    def cancel(self) -> bool:
+        """Cancel the job. Queued jobs never reach the engine; results of running jobs are discarded."""
+        with _lock:
+            if self.state in (JOB_DONE, JOB_FAILED, JOB_CANCELLED):
+                return False
+            self._cancelled = True
+            if self.state == JOB_QUEUED:
+                _queue.remove(self)
+                _awaiting_remove(self)
+                self._set_finished(JOB_CANCELLED)
+                engine_state.end_pending_sync()
+            return True
+
+    def is_cancelled(self) -> bool:
+        return self._cancelled
+
+    def is_stale(self) -> bool:
+        """Whether results of this job must be dropped (cancelled, or submitted before a cancel_all)."""
+        return self._cancelled or self.generation != _generation
+
+    def done(self) -> bool:
+        return self.state in (JOB_DONE, JOB_FAILED, JOB_CANCELLED)
+
+    def progress(self) -> float:
+        """Fraction of groups whose results have been applied."""
+        if self.state == JOB_DONE:
+            return 1.0
+        if self.group_count == 0:
+            return 0.0
+        return self.applied_groups / self.group_count
+
+    def wait_finalized(self, timeout=None) -> bool:
+        """Block until the engine finished computing (results may still be unapplied)."""
+        return self._finalized.wait(timeout)
+
+    def _set_finished(self, str state):
+        self.state = state
+        self._context = None
+        self._finalized.set()
+
+
+def _worker_loop():
+    global _running_job
+    while True:
+        with _lock:
+            while not _queue:
+                _wakeup.wait()
+            job = _queue.popleft()
+            job.state = JOB_RUNNING
+            _running_job = job
+
+        t0 = profiler.begin()
+        try:
+            job._context.finalize(job._finalize_flag)
+        except Exception as e:
+            profiler.end(STAGE_FINALIZE, t0)
+            print(f"[Pivot] Engine job failed: {e}")
+            with _lock:
+                _running_job = None
+                job.error = str(e)
+                _awaiting_remove(job)
+                job._set_finished(JOB_FAILED)
+            engine_state.end_pending_sync()
+            continue
+
+        profiler.end(STAGE_FINALIZE, t0)
+        with _lock:
+            _running_job = None
+            if job.generation != _generation:
+                # cancel_all gave up on it; its results are still posted and dropped on claim
+                job._set_finished(JOB_CANCELLED)
+                continue
+            # The shm context must stay alive until poll_mesh_sync hands back its results
+            if job.state == JOB_RUNNING:
+                job.state = JOB_AWAITING_RESULTS
+            job._finalized.set()
+
+
+cdef _awaiting_remove(job):
+    waiting = _awaiting.get(job._key)
+    if waiting is not None and job in waiting:
+        waiting.remove(job)
+        if not waiting:
+            del _awaiting[job._key]
+
+
+def submit(context, bint finalize_flag, list group_uuids):
+    """Queue context.finalize(finalize_flag) and return its StandardizeJob."""
+    global _worker
+    engine_state.begin_pending_sync()
+    with _lock:
+        job = StandardizeJob(context, finalize_flag, group_uuids)
+        if group_uuids:
+            _awaiting.setdefault(job._key, deque()).append(job)
+        _queue.append(job)
+        if _worker is None:
+            _worker = threading.Thread(target=_worker_loop, name="pivot-engine-jobs", daemon=True)
+            _worker.start()
+        _wakeup.notify()
+    return job
+
+
+def claim_job(list group_uuids):
+    """Return the job a sync context belongs to (matched on its full group uuid set) and mark it applying.
+
+    Returns None for results no submitted job accounts for; those are applied as-is.
+    """
+    key = frozenset(group_uuids)
+    with _lock:
+        waiting = _awaiting.get(key)
+        if not waiting:
+            return None
+        job = waiting.popleft()
+        if not waiting:
+            del _awaiting[key]
+        if not job.is_stale():
+            job.state = JOB_APPLYING
+        return job
+
+
+def finish_job(job) -> None:
+    """Mark a claimed job as fully applied (or dropped, if it was stale)."""
+    with _lock:
+        job._set_finished(JOB_CANCELLED if job.is_stale() else JOB_DONE)
+
+
+def active_jobs() -> list:
+    with _lock:
+        jobs = list(_queue)
+        if _running_job is not None:
+            jobs.append(_running_job)
+        for waiting in _awaiting.values():
+            jobs.extend(j for j in waiting if not j.done() and j not in jobs)
+        return jobs
+
+
+def cancel_all(bint wait=True) -> None:
+    """Cancel every job, optionally waiting for the one inside the engine to return.
+
+    Jobs that already reached the engine stay claimable, so the results they
+    still post are recognised as stale and dropped; every job ends CANCELLED.
+    """
+    global _generation
+    with _lock:
+        _generation += 1
+    for job in active_jobs():
+        job.cancel()
+    running = _running_job
+    if wait and running is not None:
+        running.wait_finalized()
+    with _lock:
+        for waiting in _awaiting.values():
+            for job in waiting:
+                # An unwaited running job is finished by the worker when finalize returns
+                if job is not _running_job and not job.done():
+                    job._set_finished(JOB_CANCELLED)
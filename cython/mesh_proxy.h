@@ -0,0 +1,189 @@
+// Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+// This file is part of the Pivot Bridge for Blender.
+
+// The Pivot Bridge for Blender is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <https://www.gnu.org/licenses>.
+
+// mesh_proxy.h - Bounded-size stand-in meshes for very dense objects.
+//
+// Used by shm_utils.pyx when an upload sets a per-object vertex budget.
+// Vertices are clustered on a uniform grid over the object's bounds; each
+// occupied cell keeps the one original vertex farthest from the bounds center,
+// so the proxy stays inside the original hull while keeping its extremes.
+// Edges and faces are remapped onto the kept vertices and collapsed ones are
+// dropped, leaving a mesh in the same layout the engine reads from shm.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace pivot_bridge {
+
+struct MeshProxy {
+    std::vector<float> positions;          // xyz per kept vertex
+    std::vector<std::int32_t> edges;       // vertex pairs
+    std::vector<std::uint32_t> loop_starts;  // first corner per face
+    std::vector<std::int32_t> corner_verts;
+};
+
+// Grid refinement passes before settling for the last resolution under budget.
+constexpr int kProxyMaxPasses = 6;
+
+namespace detail {
+
+inline std::uint64_t proxy_cell_key(std::uint32_t x, std::uint32_t y, std::uint32_t z) {
+    return (std::uint64_t(x) << 42) | (std::uint64_t(y) << 21) | std::uint64_t(z);
+}
+
+// Cell index of every vertex for a grid of res cells along the longest axis.
+// Returns the number of occupied cells; vert_cell receives dense cell ids.
+inline std::size_t proxy_assign_cells(const float* positions, std::size_t n_verts, const float lo[3],
+                                      float extent, double res, std::vector<std::int32_t>& vert_cell) {
+    std::unordered_map<std::uint64_t, std::int32_t> cells;
+    cells.reserve(static_cast<std::size_t>(res * res * 2));
+    double inv = res / extent;
+    std::uint32_t max_cell = static_cast<std::uint32_t>(res);
+    vert_cell.resize(n_verts);
+    for (std::size_t v = 0; v < n_verts; ++v) {
+        std::uint32_t c[3];
+        for (int a = 0; a < 3; ++a) {
+            double t = (positions[v * 3 + a] - lo[a]) * inv;
+            c[a] = std::min(max_cell, static_cast<std::uint32_t>(std::max(0.0, t)));
+        }
+        auto it = cells.emplace(proxy_cell_key(c[0], c[1], c[2]), static_cast<std::int32_t>(cells.size())).first;
+        vert_cell[v] = it->second;
+    }
+    return cells.size();
+}
+
+}  // namespace detail
+
+// Build a proxy with at most max_verts vertices.
+// Faces are given as loop_starts into corner_verts; face f spans
+// [loop_starts[f], loop_starts[f + 1]) with the last face ending at n_corners.
+inline void build_cluster_proxy(const float* positions, std::size_t n_verts, const std::int32_t* edges,
+                                std::size_t n_edges, const std::uint32_t* loop_starts, std::size_t n_faces,
+                                const std::int32_t* corner_verts, std::size_t n_corners, std::size_t max_verts,
+                                MeshProxy& out) {
+    out.positions.clear();
+    out.edges.clear();
+    out.loop_starts.clear();
+    out.corner_verts.clear();
+    if (n_verts == 0 || max_verts == 0) {
+        return;
+    }
+
+    float lo[3] = {positions[0], positions[1], positions[2]};
+    float hi[3] = {lo[0], lo[1], lo[2]};
+    for (std::size_t v = 1; v < n_verts; ++v) {
+        for (int a = 0; a < 3; ++a) {
+            lo[a] = std::min(lo[a], positions[v * 3 + a]);
+            hi[a] = std::max(hi[a], positions[v * 3 + a]);
+        }
+    }
+    float extent = std::max({hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]});
+    if (!(extent > 0.0f)) {
+        extent = 1.0f;
+    }
+
+    // Surfaces fill roughly res^2 cells, so start from sqrt(budget) and shrink
+    // by the overshoot until the occupied cell count fits
+    std::vector<std::int32_t> vert_cell;
+    std::vector<std::int32_t> best_cell;
+    std::size_t best_count = 0;
+    double res = std::max(1.0, std::sqrt(static_cast<double>(max_verts)));
+    for (int pass = 0; pass < kProxyMaxPasses; ++pass) {
+        std::size_t count = detail::proxy_assign_cells(positions, n_verts, lo, extent, res, vert_cell);
+        if (count <= max_verts) {
+            best_cell.swap(vert_cell);
+            best_count = count;
+            break;
+        }
+        res = std::max(1.0, res * std::sqrt(static_cast<double>(max_verts) / static_cast<double>(count)) * 0.95);
+    }
+    if (best_cell.empty()) {
+        // A 2x2x2 grid fits any budget of eight or more; below that, a single cell
+        best_count = detail::proxy_assign_cells(positions, n_verts, lo, extent, 1.0, best_cell);
+        if (best_count > max_verts) {
+            best_count = detail::proxy_assign_cells(positions, n_verts, lo, extent, 0.0, best_cell);
+        }
+    }
+
+    // Keep the vertex farthest from the bounds center in each cell
+    float center[3] = {(lo[0] + hi[0]) * 0.5f, (lo[1] + hi[1]) * 0.5f, (lo[2] + hi[2]) * 0.5f};
+    std::vector<std::int32_t> keep(best_count, -1);
+    std::vector<float> keep_dist(best_count, -1.0f);
+    for (std::size_t v = 0; v < n_verts; ++v) {
+        float dx = positions[v * 3] - center[0];
+        float dy = positions[v * 3 + 1] - center[1];
+        float dz = positions[v * 3 + 2] - center[2];
+        float d = dx * dx + dy * dy + dz * dz;
+        std::int32_t cell = best_cell[v];
+        if (d > keep_dist[cell]) {
+            keep_dist[cell] = d;
+            keep[cell] = static_cast<std::int32_t>(v);
+        }
+    }
+    out.positions.resize(best_count * 3);
+    for (std::size_t c = 0; c < best_count; ++c) {
+        std::copy_n(positions + std::size_t(keep[c]) * 3, 3, out.positions.data() + c * 3);
+    }
+
+    std::unordered_set<std::uint64_t> seen_edges;
+    seen_edges.reserve(n_edges / 4 + 16);
+    for (std::size_t e = 0; e < n_edges; ++e) {
+        std::int32_t a = best_cell[edges[e * 2]];
+        std::int32_t b = best_cell[edges[e * 2 + 1]];
+        if (a == b) {
+            continue;
+        }
+        if (a > b) {
+            std::swap(a, b);
+        }
+        if (seen_edges.insert((std::uint64_t(a) << 32) | std::uint32_t(b)).second) {
+            out.edges.push_back(a);
+            out.edges.push_back(b);
+        }
+    }
+
+    // Collapse runs of corners landing in one cell; faces left with fewer than
+    // three corners are dropped
+    for (std::size_t f = 0; f < n_faces; ++f) {
+        std::size_t begin = loop_starts[f];
+        std::size_t end = f + 1 < n_faces ? loop_starts[f + 1] : n_corners;
+        std::size_t face_start = out.corner_verts.size();
+        for (std::size_t c = begin; c < end; ++c) {
+            std::int32_t cell = best_cell[corner_verts[c]];
+            if (out.corner_verts.size() == face_start || out.corner_verts.back() != cell) {
+                out.corner_verts.push_back(cell);
+            }
+        }
+        while (out.corner_verts.size() - face_start > 1 && out.corner_verts.back() == out.corner_verts[face_start]) {
+            out.corner_verts.pop_back();
+        }
+        if (out.corner_verts.size() - face_start < 3) {
+            out.corner_verts.resize(face_start);
+        } else {
+            out.loop_starts.push_back(static_cast<std::uint32_t>(face_start));
+        }
+    }
+}
+
+}  // namespace pivot_bridge
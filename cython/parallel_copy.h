@@ -0,0 +1,168 @@
+// Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+// This file is part of the Pivot Bridge for Blender.
+
+// The Pivot Bridge for Blender is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <https://www.gnu.org/licenses>.
+
+// parallel_copy.h - Shards raw memory copies into shared memory across worker threads.
+//
+// Used by shm_utils.pyx once it has collected source/destination pointers for
+// every group. Runs without the GIL; sources must stay alive for the call.
+// Workers are started on the first parallel copy and then kept waiting for the
+// next one, so repeated uploads do not pay for thread creation.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pivot_bridge {
+
+struct CopyTask {
+    const void* src;
+    void* dst;
+    std::size_t nbytes;
+};
+
+// Below this many bytes in total the copy runs on the calling thread.
+constexpr std::size_t kParallelCopyMinBytes = 4u << 20;
+// Large tasks are split so one huge mesh cannot pin a single worker.
+constexpr std::size_t kParallelCopyChunkBytes = 1u << 20;
+
+namespace detail {
+
+// Persistent helper threads for run_copy_tasks; the calling thread always
+// takes part, so a batch on num_threads uses num_threads - 1 helpers.
+class CopyPool {
+public:
+    static CopyPool& instance() {
+        // Never destroyed: joining threads while the module unloads can deadlock
+        static CopyPool* pool = new CopyPool();
+        return *pool;
+    }
+
+    void run(const CopyTask* chunks, std::size_t count, unsigned num_threads) {
+        std::lock_guard<std::mutex> run_lock(run_mutex_);
+        unsigned helpers = num_threads - 1;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            while (workers_.size() < helpers) {
+                workers_.emplace_back([this] { worker_loop(); });
+            }
+            chunks_ = chunks;
+            count_ = count;
+            next_.store(0, std::memory_order_relaxed);
+            open_slots_ = helpers;
+            ++batch_;
+        }
+        wake_.notify_all();
+
+        drain(chunks, count);
+
+        // Close the batch so late wakers skip it, then wait for helpers inside it
+        std::unique_lock<std::mutex> lock(mutex_);
+        open_slots_ = 0;
+        done_.wait(lock, [this] { return active_ == 0; });
+        chunks_ = nullptr;
+        count_ = 0;
+    }
+
+private:
+    CopyPool() = default;
+
+    void drain(const CopyTask* chunks, std::size_t count) {
+        for (std::size_t i = next_.fetch_add(1, std::memory_order_relaxed); i < count;
+             i = next_.fetch_add(1, std::memory_order_relaxed)) {
+            std::memcpy(chunks[i].dst, chunks[i].src, chunks[i].nbytes);
+        }
+    }
+
+    void worker_loop() {
+        std::uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            wake_.wait(lock, [&] { return batch_ != seen; });
+            seen = batch_;
+            if (open_slots_ == 0) {
+                continue;
+            }
+            --open_slots_;
+            ++active_;
+            const CopyTask* chunks = chunks_;
+            std::size_t count = count_;
+            lock.unlock();
+            drain(chunks, count);
+            lock.lock();
+            if (--active_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+
+    std::mutex run_mutex_;  // one batch at a time
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::vector<std::thread> workers_;
+    const CopyTask* chunks_ = nullptr;
+    std::size_t count_ = 0;
+    std::atomic<std::size_t> next_{0};
+    std::uint64_t batch_ = 0;
+    unsigned open_slots_ = 0;
+    unsigned active_ = 0;
+};
+
+}  // namespace detail
+
+inline void run_copy_tasks(const CopyTask* tasks, std::size_t count, unsigned max_threads) {
+    std::size_t total_bytes = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        total_bytes += tasks[i].nbytes;
+    }
+
+    unsigned hw_threads = std::max(1u, std::thread::hardware_concurrency());
+    unsigned num_threads = max_threads ? std::min(max_threads, hw_threads) : hw_threads;
+
+    if (num_threads <= 1 || total_bytes < kParallelCopyMinBytes) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (tasks[i].nbytes) {
+                std::memcpy(tasks[i].dst, tasks[i].src, tasks[i].nbytes);
+            }
+        }
+        return;
+    }
+
+    std::vector<CopyTask> chunks;
+    chunks.reserve(count + total_bytes / kParallelCopyChunkBytes);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto* src = static_cast<const unsigned char*>(tasks[i].src);
+        auto* dst = static_cast<unsigned char*>(tasks[i].dst);
+        for (std::size_t offset = 0; offset < tasks[i].nbytes; offset += kParallelCopyChunkBytes) {
+            std::size_t len = std::min(kParallelCopyChunkBytes, tasks[i].nbytes - offset);
+            chunks.push_back({src + offset, dst + offset, len});
+        }
+    }
+
+    num_threads = static_cast<unsigned>(std::min<std::size_t>(num_threads, chunks.size()));
+    detail::CopyPool::instance().run(chunks.data(), chunks.size(), num_threads);
+}
+
+}  // namespace pivot_bridge
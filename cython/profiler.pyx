@@ -0,0 +1,194 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+"""Low-overhead stage profiling for the bridge data path.
+
+Usage:
+    from . import profiler
+    STAGE = profiler.stage_id("create_data_arrays.totals")
+    t0 = profiler.begin()
+    ...
+    profiler.end(STAGE, t0)
+    profiler.export_chrome_trace("/tmp/pivot_trace.json")
+
+Events are (stage id, start, end, thread) records in a fixed-size ring buffer;
+the GIL serializes writers, so no lock is taken. Built without PIVOT_PROFILING
+(the default for Release), every entry point is a no-op.
+"""
+
+include "edition_flags.pxi" # type: ignore this exists in a generated file
+
+import json
+from cpython.pythread cimport PyThread_get_thread_ident
+
+cdef extern from *:
+    """
+    #include <chrono>
+    static inline long long pivot_profiler_now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    """
+    long long pivot_profiler_now_ns() nogil
+
+cdef struct ProfileEvent:
+    int stage
+    long long start_ns
+    long long end_ns
+    unsigned long thread
+
+DEF RING_CAPACITY = 65536
+
+cdef ProfileEvent _events[RING_CAPACITY]
+cdef Py_ssize_t _head = 0      # next slot to write
+cdef Py_ssize_t _count = 0     # valid events (saturates at RING_CAPACITY)
+cdef list _stage_names = []
+cdef dict _stage_ids = {}
+cdef bint _profiling = PIVOT_PROFILING # type: ignore this exists in a generated file
+
+
+cdef inline void _record(int stage, long long start_ns, long long end_ns):
+    global _head, _count
+    cdef ProfileEvent* ev = &_events[_head]
+    ev.stage = stage
+    ev.start_ns = start_ns
+    ev.end_ns = end_ns
+    ev.thread = PyThread_get_thread_ident()
+    _head = (_head + 1) % RING_CAPACITY
+    if _count < RING_CAPACITY:
+        _count += 1
+
+
+def enabled() -> bool:
+    """Whether this build records events."""
+    return _profiling
+
+
+def stage_id(str name) -> int:
+    """Register a stage name once and return its id for begin/end."""
+    cdef object sid = _stage_ids.get(name)
+    if sid is None:
+        sid = len(_stage_names)
+        _stage_names.append(name)
+        _stage_ids[name] = sid
+    return sid
+
+
+def begin() -> int:
+    """Return a start timestamp to pass to end()."""
+    if _profiling:
+        return pivot_profiler_now_ns()
+    return 0
+
+
+def end(int stage, long long start_ns) -> None:
+    """Record the span from start_ns to now for stage."""
+    if _profiling:
+        _record(stage, start_ns, pivot_profiler_now_ns())
+
+
+def record(int stage, long long start_ns, long long end_ns) -> None:
+    """Record a span measured elsewhere (e.g. engine-reported timings, same clock)."""
+    if _profiling:
+        _record(stage, start_ns, end_ns)
+
+
+class scope:
+    """Context manager recording one span for a named stage."""
+
+    __slots__ = ("_stage", "_start")
+
+    def __init__(self, str name):
+        self._stage = stage_id(name)
+        self._start = 0
+
+    def __enter__(self):
+        self._start = begin()
+        return self
+
+    def __exit__(self, exc_type, exc, tb):
+        end(self._stage, self._start)
+        return False
+
+
+def reset() -> None:
+    """Drop all recorded events (stage registrations are kept)."""
+    global _head, _count
+    _head = 0
+    _count = 0
+
+
+def events() -> list:
+    """Recorded events in chronological order as (stage name, start_ns, end_ns, thread)."""
+    cdef list out = []
+    cdef Py_ssize_t first = (_head - _count) % RING_CAPACITY
+    cdef Py_ssize_t i
+    cdef ProfileEvent* ev
+    for i in range(_count):
+        ev = &_events[(first + i) % RING_CAPACITY]
+        out.append((_stage_names[ev.stage], ev.start_ns, ev.end_ns, ev.thread))
+    return out
+
+
+def summary() -> dict:
+    """Per-stage totals: {name: {"count", "total_ms", "max_ms"}}."""
+    cdef dict out = {}
+    for name, start_ns, end_ns, thread in events():
+        ms = (end_ns - start_ns) / 1e6
+        entry = out.get(name)
+        if entry is None:
+            out[name] = {"count": 1, "total_ms": ms, "max_ms": ms}
+        else:
+            entry["count"] += 1
+            entry["total_ms"] += ms
+            if ms > entry["max_ms"]:
+                entry["max_ms"] = ms
+    return out
+
+
+def print_summary(str title="[Pivot] Profile") -> None:
+    """Print the per-stage summary; silent in builds without profiling."""
+    if not _profiling:
+        return
+    stats = summary()
+    if not stats:
+        return
+    print(title)
+    for name, entry in sorted(stats.items(), key=lambda kv: -kv[1]["total_ms"]):
+        print(f"  {name}: {entry['total_ms']:.2f} ms over {entry['count']} (max {entry['max_ms']:.2f} ms)")
+
+
+def export_chrome_trace(str path, list extra_events=None) -> None:
+    """Write recorded events as a Chrome trace (chrome://tracing, Perfetto).
+
+    extra_events may carry spans from other sources as (name, start_ns, end_ns, thread label).
+    """
+    cdef list trace = []
+    cdef list source = events()
+    if extra_events:
+        source.extend(extra_events)
+    for name, start_ns, end_ns, thread in source:
+        trace.append({
+            "name": name,
+            "ph": "X",
+            "ts": start_ns / 1000.0,
+            "dur": (end_ns - start_ns) / 1000.0,
+            "pid": "pivot",
+            "tid": str(thread),
+        })
+    with open(path, "w", encoding="utf-8") as f:
+        json.dump({"traceEvents": trace, "displayTimeUnit": "ms"}, f)
@@ -19,7 +19,7 @@
 
 # cython: language_level=3
 import bpy
-from . import edition_utils
+from . import edition_utils, shm_utils
 from pivot_lib import id_manager
 
 # Constants (must match pivot/surface_manager.py)
@@ -29,29 +29,250 @@ CLASSIFICATION_ROOT_MARKER_PROP = "pivot_is_classification_root"
 
 cdef str MESH_TYPE = "MESH"
 
-def aggregate_object_groups(list selected_objects):
-    """Group the selection by collection boundaries and root parents."""
+# ---------------------------------------------------------------------------
+# Group index
+# ---------------------------------------------------------------------------
+# Maps every collection below the objects collection (by session_uid) to the
+# top-level child collections it is nested in, so grouping can walk outward
+# from the selection through obj.users_collection instead of scanning every
+# group's all_objects. The index only covers collections, never objects, so a
+# rebuild costs O(collections). It is dropped on depsgraph collection updates
+# and double-checked against a cheap fingerprint for edits that bypass the
+# depsgraph (e.g. bpy.data removals in background mode).
+
+cdef dict _collection_groups = {}   # collection session_uid -> tuple of top-level positions
+cdef list _top_level = []           # position -> top-level collection
+cdef tuple _index_key = None
+cdef dict _collection_has_mesh = {} # top-level collection session_uid -> bool (poll/UI cache)
+
+
+def invalidate_group_index() -> None:
+    """Drop the group index; it is rebuilt on the next lookup."""
+    global _index_key
+    _index_key = None
+    _collection_groups.clear()
+    _top_level.clear()
+    _collection_has_mesh.clear()
+
+
+cdef tuple _index_fingerprint(object scene_coll):
+    return (scene_coll.session_uid, len(scene_coll.children), len(bpy.data.collections))
+
+
+cdef int _ensure_group_index(object scene_coll) except -1:
+    global _index_key
+    cdef tuple key = _index_fingerprint(scene_coll)
+    if key == _index_key:
+        return 0
+
+    _collection_groups.clear()
+    _top_level.clear()
+    _collection_has_mesh.clear()
+
+    cdef Py_ssize_t pos
+    cdef object col
+    cdef object child
+    cdef object existing
+    for col in scene_coll.children:
+        if col.get(CLASSIFICATION_MARKER_PROP) or col.get(CLASSIFICATION_ROOT_MARKER_PROP):
+            continue
+        pos = len(_top_level)
+        _top_level.append(col)
+        for child in (col, *col.children_recursive):
+            existing = _collection_groups.get(child.session_uid)
+            if existing is None:
+                _collection_groups[child.session_uid] = (pos,)
+            elif existing[-1] != pos:
+                _collection_groups[child.session_uid] = existing + (pos,)
+
+    _index_key = key
+    return 0
+
+
+def find_object_groups(list objects, object scene_coll=None):
+    """Return (collections, roots): the groups that contain any of objects.
+
+    collections are top-level children of the objects collection in scene
+    order; roots are parentless objects linked directly to the objects
+    collection whose hierarchy contains one of objects, in discovery order.
+    Cost scales with the number of given objects, not with the scene.
+    """
+    if scene_coll is None:
+        scene_coll = id_manager.get_objects_collection()
+    if scene_coll is None:
+        return [], []
+
+    try:
+        _ensure_group_index(scene_coll)
+        return _find_object_groups(objects, scene_coll)
+    except ReferenceError:
+        # A collection was removed without a depsgraph update reaching us
+        invalidate_group_index()
+        _ensure_group_index(scene_coll)
+        return _find_object_groups(objects, scene_coll)
+
+
+cdef tuple _find_object_groups(list objects, object scene_coll):
+    cdef set positions = set()
+    cdef list roots = []
+    cdef set root_uids = set()
+    cdef object obj
+    cdef object col
+    cdef object root
+    cdef object hit
+    cdef object scene_objects = scene_coll.objects
+
+    for obj in objects:
+        for col in obj.users_collection:
+            hit = _collection_groups.get(col.session_uid)
+            if hit is not None:
+                positions.update(hit)
+
+        root = obj
+        while root.parent is not None:
+            root = root.parent
+        if root.session_uid not in root_uids and root.name in scene_objects:
+            root_uids.add(root.session_uid)
+            roots.append(root)
+
+    return [_top_level[pos] for pos in sorted(positions)], roots
+
+
+def find_collection_groups(list cols, object scene_coll=None) -> list:
+    """Return the top-level collections (in scene order) that cols are, or are nested in."""
+    if scene_coll is None:
+        scene_coll = id_manager.get_objects_collection()
+    if scene_coll is None or not cols:
+        return []
+
+    cdef set positions = set()
+    cdef object col
+    cdef object hit
+    try:
+        _ensure_group_index(scene_coll)
+        for col in cols:
+            hit = _collection_groups.get(col.session_uid)
+            if hit is not None:
+                positions.update(hit)
+    except ReferenceError:
+        invalidate_group_index()
+        return find_collection_groups([c for c in cols if _is_alive(c)], scene_coll)
+    return [_top_level[pos] for pos in sorted(positions)]
+
+
+cdef bint _is_alive(object id_block):
+    try:
+        id_block.session_uid
+        return True
+    except ReferenceError:
+        return False
+
+
+def group_has_mesh(object group) -> bool:
+    """Whether a group from find_object_groups (collection or root object) holds any mesh.
+
+    Collection answers are cached until the group index is invalidated, which
+    every membership change does; root hierarchies are checked directly.
+    """
+    cdef object cached
+    if isinstance(group, bpy.types.Collection):
+        cached = _collection_has_mesh.get(group.session_uid)
+        if cached is None:
+            cached = any(o.type == MESH_TYPE for o in group.all_objects)
+            _collection_has_mesh[group.session_uid] = cached
+        return cached
+    return group.type == MESH_TYPE or any(o.type == MESH_TYPE for o in group.children_recursive)
+
+
+cdef bint _needs_evaluation(object obj):
+    """Whether obj's evaluated geometry can differ from its base mesh.
+
+    Viewport modifiers (including geometry nodes, hooks and armatures), shape
+    keys and edit mode are what change it; transforms and constraints do not.
+    """
+    cdef object mod
+    for mod in obj.modifiers:
+        if mod.show_viewport:
+            return True
+    return obj.mode == 'EDIT' or obj.data.shape_keys is not None
+
+
+cdef object _evaluated_members(object members, list depsgraph_ref, bint base_meshes):
+    """Meshes of members as a shm_utils.MeshGroup.
+
+    With base_meshes, objects whose geometry cannot differ from their mesh
+    datablock upload it directly; the depsgraph in depsgraph_ref[0] is only
+    fetched (and with it, pending evaluation run) for the others.
+    """
+    cdef object group = shm_utils.MeshGroup()
+    cdef object obj
+    cdef object eval_obj
+    for obj in members:
+        if obj.type == MESH_TYPE:
+            try:
+                if base_meshes and not _needs_evaluation(obj):
+                    group.add(obj, obj.data)
+                    continue
+                if depsgraph_ref[0] is None:
+                    depsgraph_ref[0] = bpy.context.evaluated_depsgraph_get()
+                eval_obj = obj.evaluated_get(depsgraph_ref[0])
+                group.add(eval_obj, eval_obj.data)
+            except (RuntimeError, AttributeError):
+                continue
+    return group
+
+
+def mesh_groups_for_objects(list objects, bint base_meshes=True):
+    """One single-object MeshGroup per object with vertices.
+
+    Returns (mesh_groups, objects kept), in input order.
+    """
+    cdef list depsgraph_ref = [None]
+    cdef list groups = []
+    cdef list kept = []
+    cdef object obj
+    cdef object group
+    for obj in objects:
+        group = _evaluated_members((obj,), depsgraph_ref, base_meshes)
+        if group.upload_verts() == 0:
+            continue
+        groups.append(group)
+        kept.append(obj)
+    return groups, kept
+
+
+def aggregate_object_groups(list selected_objects, bint skip_current=False, bint base_meshes=True):
+    """Group the selection by collection boundaries and root parents.
+
+    Returns (mesh_groups, group_names, collections); mesh_groups holds one
+    shm_utils.MeshGroup per group.
+
+    With skip_current, groups whose asset id_manager.is_asset_current reports
+    as unchanged since their last upload are left out before evaluation.
+    With base_meshes, objects without modifiers or shape keys read their mesh
+    datablock and the depsgraph is only evaluated if some object needs it.
+    """
 
     if edition_utils.is_standard_edition() and len(selected_objects) != 1:
         raise ValueError("Standard edition only supports single object selection")
 
     cdef object scene_coll = id_manager.get_objects_collection()
     if not scene_coll.objects and not scene_coll.children:
-        return [], []
-
-    # Get Depsgraph (Unavoidable overhead on first run)
-    cdef object depsgraph = bpy.context.evaluated_depsgraph_get()
-    cdef str marker = CLASSIFICATION_MARKER_PROP
+        return [], [], []
 
     # --- 1. Selection Setup ---
-    cdef set sel_set = set(selected_objects)
-    
-    # Filter selection to meshes only. 
+    # Filter selection to meshes only.
     # This is small (User selection size), so it's fast.
-    cdef set sel_set_meshes = {o for o in sel_set if o.type == MESH_TYPE}
-    
-    if not sel_set_meshes:
-        return [], []
+    cdef list sel_meshes = [o for o in selected_objects if o.type == MESH_TYPE]
+
+    if not sel_meshes:
+        return [], [], []
+
+    # Only the groups the selection touches are visited below
+    group_cols, roots = find_object_groups(sel_meshes, scene_coll)
+
+    # Fetched on first use; skipped entirely when every object uploads its base mesh
+    cdef list depsgraph_ref = [None]
 
     cdef list group_names = []
     cdef list mesh_groups = []
@@ -61,74 +282,33 @@ def aggregate_object_groups(list selected_objects):
     cdef object root_obj
     cdef object new_col
     cdef object obj
-    cdef object eval_obj
-    cdef object eval_mesh
-    
+
     cdef set col_objects_set
-    cdef list eval_members
+    cdef object eval_members
     cdef str new_col_name
+    cdef object asset_uuid
+    cdef Py_ssize_t skipped = 0
 
-    cdef list mesh_members_list = []
-    
     # --- 2. Pass 1: Existing Collections ---
-    for col in scene_coll.children:
-        if col.get(marker) or col.get(CLASSIFICATION_ROOT_MARKER_PROP):
-            continue
-
-        col_objects_set = set(col.all_objects)
-        
-        # Optimization: Fail-Fast
-        # If the collection doesn't touch our selection, skip it entirely.
-        if col_objects_set.isdisjoint(sel_set_meshes):
-            continue
-
-        # If we are here, this collection is relevant.
-        # NOW we filter for meshes, only on this specific subset.
-        eval_members = []
-        for obj in col_objects_set:
-            if obj.type == MESH_TYPE:
-                # We also check if it's in the selection OR in the scene_coll scope
-                # (Assuming col.all_objects implies it is in scope, we just need type check)
-                try:
-                    eval_obj = obj.evaluated_get(depsgraph)
-                    eval_mesh = eval_obj.data
-                    eval_members.append((eval_obj, eval_mesh, eval_mesh.vertices, eval_mesh.edges, eval_mesh.loops, eval_mesh.polygons))
-                except (RuntimeError, AttributeError):
-                    continue
-
+    for col in group_cols:
+        if skip_current:
+            asset_uuid = col.get(id_manager.PIVOT_ASSET_ID)
+            if asset_uuid is not None and id_manager.is_asset_current(bytes(asset_uuid)):
+                skipped += 1
+                continue
+        eval_members = _evaluated_members(set(col.all_objects), depsgraph_ref, base_meshes)
         if eval_members:
             mesh_groups.append(eval_members)
             group_names.append(col.name)
             collections.append(col)
 
     # --- 3. Pass 2: Root Objects ---
-    # Iterate over tuple copy to handle list mutation safely
-    all_objects = tuple(scene_coll.objects)
-    for root_obj in all_objects:
-        if root_obj.parent is not None: continue
-        
+    for root_obj in roots:
         # Build hierarchy set
         col_objects_set = set(root_obj.children_recursive)
         col_objects_set.add(root_obj)
 
-        # Optimization: Fail-Fast
-        if col_objects_set.isdisjoint(sel_set_meshes):
-            continue
-
-        # Process valid hierarchy
-        eval_members = []
-        mesh_members_list = [] # Temporary list for relinking
-
-        for obj in col_objects_set:
-            if obj.type == MESH_TYPE:
-                try:
-                    eval_obj = obj.evaluated_get(depsgraph)
-                    eval_mesh = eval_obj.data
-                    eval_members.append((eval_obj, eval_mesh, eval_mesh.vertices, eval_mesh.edges, eval_mesh.loops, eval_mesh.polygons))
-                    mesh_members_list.append(obj)
-                except (RuntimeError, AttributeError):
-                    continue
-        
+        eval_members = _evaluated_members(col_objects_set, depsgraph_ref, base_meshes)
         if eval_members:
             mesh_groups.append(eval_members)
 
@@ -149,4 +329,6 @@ def aggregate_object_groups(list selected_objects):
                 except RuntimeError:
                     pass
 
-    return mesh_groups, group_names, collections
\ No newline at end of file
+    if skipped:
+        print(f"[Pivot] Skipped {skipped} groups unchanged since their last upload")
+    return mesh_groups, group_names, collections
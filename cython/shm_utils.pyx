@@ -17,47 +17,318 @@
 
 import elbo_sdk_rust as engine
 import json
-from libc.stdint cimport uint32_t
+from libc.stdint cimport int32_t, uint32_t, uintptr_t
 from libc.string cimport memcpy, memset
-from .timer_manager import timers
-from . import id_manager
+from libcpp.unordered_map cimport unordered_map
+from libcpp.vector cimport vector
+from cython.operator cimport dereference as deref
+from . import id_manager, transform_utils, profiler
 
-def create_data_arrays(list mesh_groups, list group_names, list uuids, list surface_contexts):
-    # Build counts and object names without generators to avoid closures
+cdef extern from "parallel_copy.h" namespace "pivot_bridge":
+    cdef struct CopyTask:
+        const void* src
+        void* dst
+        size_t nbytes
+    void run_copy_tasks(const CopyTask* tasks, size_t count, unsigned max_threads) nogil
+
+cdef extern from "mesh_proxy.h" namespace "pivot_bridge":
+    cdef cppclass MeshProxy:
+        vector[float] positions
+        vector[int32_t] edges
+        vector[uint32_t] loop_starts
+        vector[int32_t] corner_verts
+    void build_cluster_proxy(const float* positions, size_t n_verts, const int32_t* edges, size_t n_edges,
+                             const uint32_t* loop_starts, size_t n_faces, const int32_t* corner_verts,
+                             size_t n_corners, size_t max_verts, MeshProxy& out) nogil
+
+# Fixed per-object name slot in object_names_shm; the layout is owned by the engine
+DEF MAX_NAME_LEN = 64  # keep in sync with pivot_com_types::MAX_NAME_LEN
+
+# Every upload fills edges, loop starts and corner verts. The engine reads all
+# three for every operation (origin and rotation share one finalize(False)), so
+# a buffer can only be skipped once the engine reports what an operation reads.
+
+# Geometry precision of a request (create_data_arrays precision=). Anything but
+# PRECISION_FULL is only sent to an engine that lists it in
+# SUPPORTED_UPLOAD_PRECISIONS.
+PRECISION_FULL = 0       # float32 positions, int32 indices
+PRECISION_QUANTIZED = 1  # 16-bit positions within each object's bounds, 16-bit local indices
+
+# Reused across calls; clear() keeps the capacity of the largest upload so far
+cdef vector[CopyTask] _copy_tasks
+
+# Where the first object using a mesh datablock put its geometry in shm
+cdef struct SharedMesh:
+    Py_ssize_t n_verts
+    Py_ssize_t n_edges
+    Py_ssize_t n_faces
+    Py_ssize_t n_corners
+    void* verts
+    void* edges
+    void* loop_starts
+    void* corner_verts
+
+# Evaluated mesh pointer -> its first copy, and shm-to-shm copies of the
+# duplicates; both live for one create_data_arrays call
+cdef unordered_map[uintptr_t, SharedMesh] _shared_meshes
+cdef vector[CopyTask] _dup_tasks
+
+# Full geometry of the object being reduced to a proxy; reused across objects
+cdef vector[float] _src_positions
+cdef vector[int32_t] _src_edges
+cdef vector[uint32_t] _src_loop_starts
+cdef vector[int32_t] _src_corner_verts
+
+cdef int STAGE_TOTALS = profiler.stage_id("create_data_arrays.totals")
+cdef int STAGE_PROXY = profiler.stage_id("create_data_arrays.totals.proxy")
+cdef int STAGE_MAKE_SHM = profiler.stage_id("create_data_arrays.make_shm")
+cdef int STAGE_SCENE_TRANSFORMS = profiler.stage_id("create_data_arrays.scene_transforms")
+cdef int STAGE_GROUP = profiler.stage_id("create_data_arrays.group")
+cdef int STAGE_UUIDS = profiler.stage_id("create_data_arrays.group.uuids")
+cdef int STAGE_TRANSFORMS = profiler.stage_id("create_data_arrays.group.transforms")
+cdef int STAGE_GEOMETRY = profiler.stage_id("create_data_arrays.group.geometry")
+cdef int STAGE_PARALLEL_COPY = profiler.stage_id("create_data_arrays.parallel_copy")
+cdef int STAGE_DUPLICATE_COPY = profiler.stage_id("create_data_arrays.duplicate_copy")
+
+cdef bint _queue_raw_copy(vector[CopyTask]* tasks, object collection, void* dst, size_t nbytes):
+    """Queue a copy straight from a contiguous Blender array.
+
+    Returns False when the collection does not expose its storage, in which case
+    the caller falls back to foreach_get.
+    """
+    cdef CopyTask task
+    try:
+        task.src = <const void*><uintptr_t>collection[0].as_pointer()
+    except (AttributeError, IndexError, TypeError):
+        return False
+    if task.src == NULL:
+        return False
+    task.dst = dst
+    task.nbytes = nbytes
+    tasks.push_back(task)
+    return True
+
+cdef inline void _queue_copy(vector[CopyTask]* tasks, const void* src, void* dst, size_t nbytes):
+    cdef CopyTask task
+    task.src = src
+    task.dst = dst
+    task.nbytes = nbytes
+    tasks.push_back(task)
+
+cdef int _read_attribute(object collection, str prop, void* dst, size_t nbytes, str fmt) except -1:
+    """Copy a whole attribute into dst, straight from Blender's storage when it is exposed."""
+    cdef const void* src = NULL
+    if nbytes == 0:
+        return 0
+    try:
+        src = <const void*><uintptr_t>collection[0].as_pointer()
+    except (AttributeError, IndexError, TypeError):
+        src = NULL
+    if src != NULL:
+        memcpy(dst, src, nbytes)
+    else:
+        collection.foreach_get(prop, memoryview(<unsigned char[:nbytes]><unsigned char*>dst).cast(fmt))
+    return 0
+
+cdef class _ProxyMesh:
+    """Reduced geometry uploaded in place of one dense object."""
+    cdef MeshProxy data
+
+cdef _ProxyMesh _build_proxy(object mesh, Py_ssize_t n_verts, Py_ssize_t n_edges, Py_ssize_t n_faces, Py_ssize_t n_corners, size_t budget):
+    _src_positions.resize(n_verts * 3)
+    _src_edges.resize(n_edges * 2)
+    _src_loop_starts.resize(n_faces)
+    _src_corner_verts.resize(n_corners)
+    _read_attribute(mesh.attributes["position"].data, "vector", _src_positions.data(), n_verts * 3 * sizeof(float), 'f')
+    if n_edges:
+        _read_attribute(mesh.attributes[".edge_verts"].data, "value", _src_edges.data(), n_edges * 2 * sizeof(int32_t), 'i')
+    if n_faces:
+        _read_attribute(mesh.polygons, "loop_start", _src_loop_starts.data(), n_faces * sizeof(uint32_t), 'I')
+    if n_corners:
+        _read_attribute(mesh.attributes[".corner_vert"].data, "value", _src_corner_verts.data(), n_corners * sizeof(int32_t), 'i')
+
+    cdef _ProxyMesh proxy = _ProxyMesh()
+    with nogil:
+        build_cluster_proxy(_src_positions.data(), n_verts, _src_edges.data(), n_edges,
+                            _src_loop_starts.data(), n_faces, _src_corner_verts.data(), n_corners,
+                            budget, proxy.data)
+    return proxy
+
+cdef Py_ssize_t _utf8_prefix_len(const unsigned char* data, Py_ssize_t length, Py_ssize_t limit):
+    """Longest prefix of at most limit bytes that does not split a UTF-8 sequence."""
+    if length <= limit:
+        return length
+    # Back off continuation bytes (10xxxxxx) so the cut lands on a code point boundary
+    while limit > 0 and (data[limit] & 0xC0) == 0x80:
+        limit -= 1
+    return limit
+
+cdef class MeshGroup:
+    """Evaluated meshes of one group with their element counts, read once at acquisition.
+
+    Counts are kept in typed arrays, so sizing and copying in create_data_arrays
+    never go back to Blender collections just to call len().
+    """
+    cdef list objects               # evaluated objects
+    cdef list meshes                # their evaluated meshes
+    cdef vector[uint32_t] vert_counts
+    cdef vector[uint32_t] edge_counts
+    cdef vector[uint32_t] face_counts
+    cdef vector[uint32_t] corner_counts
+    cdef Py_ssize_t vert_total
+    cdef Py_ssize_t edge_total
+    cdef Py_ssize_t face_total
+    cdef Py_ssize_t corner_total
+
+    def __cinit__(self):
+        self.objects = []
+        self.meshes = []
+
+    def add(self, eval_obj, eval_mesh) -> None:
+        """Append an evaluated object and record its element counts."""
+        cdef uint32_t n_verts = len(eval_mesh.vertices)
+        cdef uint32_t n_edges = len(eval_mesh.edges)
+        cdef uint32_t n_faces = len(eval_mesh.polygons)
+        cdef uint32_t n_corners = len(eval_mesh.loops)
+        self.objects.append(eval_obj)
+        self.meshes.append(eval_mesh)
+        self.vert_counts.push_back(n_verts)
+        self.edge_counts.push_back(n_edges)
+        self.face_counts.push_back(n_faces)
+        self.corner_counts.push_back(n_corners)
+        self.vert_total += n_verts
+        self.edge_total += n_edges
+        self.face_total += n_faces
+        self.corner_total += n_corners
+
+    def __len__(self):
+        return len(self.objects)
+
+    def originals(self) -> list:
+        """Original (non-evaluated) objects in upload order."""
+        return [obj.original for obj in self.objects]
+
+    def signature(self) -> tuple:
+        return (len(self.objects), self.vert_total, self.edge_total, self.face_total, self.corner_total)
+
+    cpdef Py_ssize_t upload_verts(self, Py_ssize_t proxy_vertex_budget=0):
+        """Vertices this group puts into shm once objects above the budget are proxied."""
+        cdef Py_ssize_t total = 0
+        cdef size_t i
+        if proxy_vertex_budget <= 0:
+            return self.vert_total
+        for i in range(self.vert_counts.size()):
+            total += self.vert_counts[i] if self.vert_counts[i] <= proxy_vertex_budget else proxy_vertex_budget
+        return total
+
+def supports_precision(int precision) -> bool:
+    """Whether the running engine accepts uploads at precision."""
+    return precision == PRECISION_FULL or precision in getattr(engine, "SUPPORTED_UPLOAD_PRECISIONS", ())
+
+def group_signature(MeshGroup group):
+    """Cheap geometry signature for a group: object count plus element totals.
+
+    Used together with the depsgraph-driven sync flag to decide whether a group
+    has to be uploaded again or whether the engine already holds its results.
+    """
+    return group.signature()
+
+def create_data_arrays(list mesh_groups, list group_names, list uuids, list surface_contexts, bint parallel=True, bint write_names=True, Py_ssize_t proxy_vertex_budget=0, int precision=PRECISION_FULL):
+    """Size the shm segments for all groups and fill them.
+
+    With parallel set, geometry whose storage Blender exposes directly is first
+    collected as raw copy tasks for every group and then copied into shm by a
+    thread pool with the GIL released. Anything else goes through foreach_get.
+
+    Object names are only informational for the engine (objects are keyed by
+    UUID); without write_names the name slots are zeroed instead of encoded.
+    Names longer than MAX_NAME_LEN bytes are cut on a UTF-8 boundary.
+
+    With a positive proxy_vertex_budget, objects with more vertices than that
+    are uploaded as a vertex-clustered proxy of at most that many vertices
+    (see mesh_proxy.h) instead of their full evaluated mesh.
+
+    Objects whose evaluated mesh is shared with an earlier object in the call
+    (linked duplicates without modifiers), in any group, are read from Blender
+    once; the copies are filled from the first one inside shm.
+
+    A precision other than PRECISION_FULL is passed on to
+    prepare_standardize_groups so the engine reduces its working copy; shm
+    is still filled at full precision. Raises ValueError if the engine does
+    not support the precision.
+    """
+    if not supports_precision(precision):
+        raise ValueError(f"engine does not support upload precision {precision}")
+
+    # Shm sizes per group; totals come from the MeshGroup counts
     cdef list vert_counts_list = []
     cdef list edge_counts_list = []
     cdef list face_counts_list = []
     cdef list face_corner_counts_list = []
     cdef list object_counts_list = []
-    cdef list object_names_list = []
-    cdef list group
+    cdef Py_ssize_t truncated_names = 0
+    cdef Py_ssize_t proxied_objects = 0
+    cdef Py_ssize_t deduped_objects = 0
+    cdef MeshGroup group
+    cdef Py_ssize_t obj_index
     cdef object obj
     cdef object mesh
+    # Per group: None, or one proxy (or None) per object; keeps proxies alive until the copy ran
+    cdef list group_proxies = []
+    cdef list proxies
+    cdef _ProxyMesh proxy
+    cdef dict proxy_by_mesh = {}
+    cdef uintptr_t mesh_key
+    cdef unordered_map[uintptr_t, SharedMesh].iterator shared_it
+    cdef SharedMesh shared
     
-    timers.start("create_data_arrays.totals")
+    cdef long long t0 = profiler.begin()
+    cdef long long t_group
+    # Drop tasks left behind by an upload that raised before its copy ran
+    _copy_tasks.clear()
+    _dup_tasks.clear()
+    _shared_meshes.clear()
     for group in mesh_groups:
-        object_counts_list.append(len(group))
-        group_vert_total = 0
-        group_edge_total = 0
-        group_face_total = 0
-        group_face_corner_total = 0
-        for i, (obj, mesh, verts, edges, loops, polygons) in enumerate(group):
-            object_names_list.append(obj.name)
-            group_vert_total += len(verts)
-            group_edge_total += len(edges)
-            group_face_total += len(polygons)
-            group_face_corner_total += len(loops)
+        object_counts_list.append(len(group.objects))
+        group_vert_total = group.vert_total
+        group_edge_total = group.edge_total
+        group_face_total = group.face_total
+        group_face_corner_total = group.corner_total
+        proxies = None
+        if proxy_vertex_budget > 0 and group.upload_verts(proxy_vertex_budget) < group.vert_total:
+            # Objects above the budget: swap their counts for the proxy's
+            proxies = [None] * len(group.objects)
+            for obj_index in range(len(group.objects)):
+                if group.vert_counts[obj_index] <= proxy_vertex_budget:
+                    continue
+                mesh = group.meshes[obj_index]
+                # Linked duplicates share one proxy
+                mesh_key = <uintptr_t>mesh.as_pointer()
+                proxy = proxy_by_mesh.get(mesh_key)
+                if proxy is None:
+                    t_group = profiler.begin()
+                    proxy = _build_proxy(mesh, group.vert_counts[obj_index], group.edge_counts[obj_index],
+                                         group.face_counts[obj_index], group.corner_counts[obj_index], proxy_vertex_budget)
+                    profiler.end(STAGE_PROXY, t_group)
+                    proxy_by_mesh[mesh_key] = proxy
+                proxies[obj_index] = proxy
+                proxied_objects += 1
+                group_vert_total += <Py_ssize_t>(proxy.data.positions.size() // 3) - group.vert_counts[obj_index]
+                group_edge_total += <Py_ssize_t>(proxy.data.edges.size() // 2) - group.edge_counts[obj_index]
+                group_face_total += <Py_ssize_t>proxy.data.loop_starts.size() - group.face_counts[obj_index]
+                group_face_corner_total += <Py_ssize_t>proxy.data.corner_verts.size() - group.corner_counts[obj_index]
+        group_proxies.append(proxies)
         vert_counts_list.append(group_vert_total)
         edge_counts_list.append(group_edge_total)
         face_counts_list.append(group_face_total)
         face_corner_counts_list.append(group_face_corner_total)
 
-    print("create_data_arrays.totals: ", timers.stop("create_data_arrays.totals"), "ms")
-    timers.reset("create_data_arrays.totals")
+    profiler.end(STAGE_TOTALS, t0)
 
-    timers.start("rust.makeshm")
+    t0 = profiler.begin()
     # Prepare shared memory using the per-object counts and group data so finalize needs no args
 
+    prepare_kwargs = {} if precision == PRECISION_FULL else {"precision": precision}
     shm_context = engine.prepare_standardize_groups(
         vert_counts_list,
         edge_counts_list,
@@ -67,9 +338,9 @@ def create_data_arrays(list mesh_groups, list group_names, list uuids, list surf
         group_names,
         surface_contexts,
         uuids,
+        **prepare_kwargs,
     )
-    print("create_data_arrays.make_shm: ", timers.stop("rust.makeshm"), "ms")
-    timers.reset("rust.makeshm")
+    profiler.end(STAGE_MAKE_SHM, t0)
 
     cdef uint32_t v_cursor
     cdef uint32_t e_cursor
@@ -84,24 +355,32 @@ def create_data_arrays(list mesh_groups, list group_names, list uuids, list surf
     cdef int[::1] ecount_mv
     cdef float[::1] verts_mv
     cdef int[::1] edges_mv
-    cdef object mat
-    cdef Py_ssize_t obj_index
+    cdef int[::1] loops_mv
+    cdef uint32_t[::1] lbases_mv
+    cdef uint32_t[::1] obj_loop_counts_mv
+    cdef Py_ssize_t n_verts
+    cdef Py_ssize_t n_edges
+    cdef Py_ssize_t n_faces
+    cdef Py_ssize_t n_corners
     cdef bytes name_bytes
     cdef Py_ssize_t name_len
     cdef const unsigned char* name_ptr
-    cdef float *outp
-    cdef bytes uuid_seq
-    cdef const unsigned char *uuid_ptr
 
-    timers.start("data_arrays.loop")
+    # One foreach_get over bpy.data.objects replaces 16 indexations per object
+    # once the request covers a large enough share of the scene
+    cdef object scene_transforms = None
+    if transform_utils.should_bulk_read(sum(object_counts_list)):
+        t0 = profiler.begin()
+        scene_transforms = transform_utils.SceneTransforms()
+        profiler.end(STAGE_SCENE_TRANSFORMS, t0)
+
     for i, group in enumerate(mesh_groups):
+        t_group = profiler.begin()
         v_cursor = 0
         e_cursor = 0
         lb_cursor = 0
         l_cursor = 0
 
-        idx_trans = 0
-
         verts_shm, edges_shm, loops_shm, loop_bases_shm, object_loop_counts_shm, transforms_shm, vcounts_shm, ecounts_shm, object_names_shm, uuids_shm = shm_context.buffers(i)
 
         # Rust exposes raw u8 buffers; cast to typed views here.
@@ -118,94 +397,149 @@ def create_data_arrays(list mesh_groups, list group_names, list uuids, list surf
         names_mv = memoryview(object_names_shm).cast('B')
         uuids_mv = memoryview(uuids_shm).cast('B')
 
-        for obj_index in range(len(group)):
-            obj, mesh, verts, edges, loops, polygons = group[obj_index]
+        proxies = group_proxies[i]
+
+        t0 = profiler.begin()
+        originals = group.originals()
+        id_manager.fill_obj_uuids(originals, uuids_mv)
+        profiler.end(STAGE_UUIDS, t0)
+
+        t0 = profiler.begin()
+        transform_utils.read_matrices(originals, trans_mv, scene_transforms)
+        profiler.end(STAGE_TRANSFORMS, t0)
+
+        if not write_names and group.objects:
+            memset(&names_mv[0], 0, len(group.objects) * MAX_NAME_LEN)
+
+        t0 = profiler.begin()
+        for obj_index in range(len(group.objects)):
+            obj = group.objects[obj_index]
+            mesh = group.meshes[obj_index]
             vcount_mv[obj_index] = v_cursor
             ecount_mv[obj_index] = e_cursor
             obj_loop_counts_mv[obj_index] = lb_cursor
 
-            uuid_bytes = id_manager.get_or_create_obj_uuids([obj.original])
-            uuid_seq = bytes(uuid_bytes[0])
-            if len(uuid_seq) != 16:
-                raise ValueError(f"pivot uuid must be 16 bytes but got {len(uuid_seq)}")
-            uuid_ptr = <const unsigned char *>uuid_seq
-            memcpy(&uuids_mv[obj_index * 16], uuid_ptr, 16)
-
-            name_bytes = obj.name.encode('utf-8')
-            name_len = len(name_bytes)
-            if name_len > 64:
-                name_len = 64
-            name_ptr = <const unsigned char*>name_bytes
-            memcpy(&names_mv[obj_index * 64], name_ptr, name_len)
-            if name_len < 64:
-                memset(&names_mv[obj_index * 64 + name_len], 0, 64 - name_len)
-
-            mat = obj.matrix_world
-            # Fallback: cache rows to reduce repeated Python lookups.
-            r0 = mat[0]
-            r1 = mat[1]
-            r2 = mat[2]
-            r3 = mat[3]
-            outp = &trans_mv[idx_trans]
-            outp[0] = <float>r0[0]
-            outp[1] = <float>r1[0]
-            outp[2] = <float>r2[0]
-            outp[3] = <float>r3[0]
-            outp[4] = <float>r0[1]
-            outp[5] = <float>r1[1]
-            outp[6] = <float>r2[1]
-            outp[7] = <float>r3[1]
-            outp[8] = <float>r0[2]
-            outp[9] = <float>r1[2]
-            outp[10] = <float>r2[2]
-            outp[11] = <float>r3[2]
-            outp[12] = <float>r0[3]
-            outp[13] = <float>r1[3]
-            outp[14] = <float>r2[3]
-            outp[15] = <float>r3[3]
-
-            idx_trans += 16
-
-            timers.start("create_data_arrays.loop.foreach_get_verts")
-            mesh.attributes["position"].data.foreach_get("vector", verts_mv[v_cursor * 3:v_cursor * 3 + len(verts) * 3])
-            v_cursor += len(verts)
-            timers.stop("create_data_arrays.loop.foreach_get_verts")
-
-            timers.start("create_data_arrays.loop.foreach_get_edges")
-            mesh.attributes[".edge_verts"].data.foreach_get("value", edges_mv[e_cursor * 2:e_cursor * 2 + len(edges) * 2])
-            e_cursor += len(edges)
-            timers.stop("create_data_arrays.loop.foreach_get_edges")
-
-            timers.start("create_data_arrays.loop.foreach_get_loop_start")
-            polygons.foreach_get("loop_start", lbases_mv[lb_cursor:lb_cursor + len(polygons)])
-            lb_cursor += len(polygons)
-            timers.stop("create_data_arrays.loop.foreach_get_loop_start")
-
-            timers.start("create_data_arrays.loop.foreach_get_loops")
-            mesh.attributes[".corner_vert"].data.foreach_get("value", loops_mv[l_cursor:l_cursor + len(loops)])
-            l_cursor += len(loops)
-            timers.stop("create_data_arrays.loop.foreach_get_loops")
+            if write_names:
+                name_bytes = obj.name.encode('utf-8')
+                name_ptr = <const unsigned char*>name_bytes
+                name_len = _utf8_prefix_len(name_ptr, len(name_bytes), MAX_NAME_LEN)
+                if name_len < len(name_bytes):
+                    truncated_names += 1
+                memcpy(&names_mv[obj_index * MAX_NAME_LEN], name_ptr, name_len)
+                if name_len < MAX_NAME_LEN:
+                    memset(&names_mv[obj_index * MAX_NAME_LEN + name_len], 0, MAX_NAME_LEN - name_len)
 
-        # Sentinel totals (bases length = object_count + 1)
-        vcount_mv[len(group)] = v_cursor
-        ecount_mv[len(group)] = e_cursor
-        obj_loop_counts_mv[len(group)] = lb_cursor
-        
+            # Linked duplicates: copy the first object's geometry within shm
+            # instead of reading the same mesh from Blender again
+            mesh_key = <uintptr_t>mesh.as_pointer()
+            shared_it = _shared_meshes.find(mesh_key)
+            if shared_it != _shared_meshes.end():
+                shared = deref(shared_it).second
+                if shared.n_verts:
+                    _queue_copy(&_dup_tasks, shared.verts, &verts_mv[v_cursor * 3], shared.n_verts * 3 * sizeof(float))
+                if shared.n_edges:
+                    _queue_copy(&_dup_tasks, shared.edges, &edges_mv[e_cursor * 2], shared.n_edges * 2 * sizeof(int))
+                if shared.n_faces:
+                    _queue_copy(&_dup_tasks, shared.loop_starts, &lbases_mv[lb_cursor], shared.n_faces * sizeof(uint32_t))
+                if shared.n_corners:
+                    _queue_copy(&_dup_tasks, shared.corner_verts, &loops_mv[l_cursor], shared.n_corners * sizeof(int))
+                v_cursor += shared.n_verts
+                e_cursor += shared.n_edges
+                lb_cursor += shared.n_faces
+                l_cursor += shared.n_corners
+                deduped_objects += 1
+                continue
 
-    print("create_data_arrays.loop.foreach_get_verts: ", timers.get_elapsed_ms("create_data_arrays.loop.foreach_get_verts"), "ms")
-    timers.reset("create_data_arrays.loop.foreach_get_verts")
+            proxy = proxies[obj_index] if proxies is not None else None
+            if proxy is not None:
+                n_verts = proxy.data.positions.size() // 3
+                n_edges = proxy.data.edges.size() // 2
+                n_faces = proxy.data.loop_starts.size()
+                n_corners = proxy.data.corner_verts.size()
+            else:
+                n_verts = group.vert_counts[obj_index]
+                n_edges = group.edge_counts[obj_index]
+                n_faces = group.face_counts[obj_index]
+                n_corners = group.corner_counts[obj_index]
 
-    print("create_data_arrays.loop.foreach_get_edges: ", timers.get_elapsed_ms("create_data_arrays.loop.foreach_get_edges"), "ms")
-    timers.reset("create_data_arrays.loop.foreach_get_edges")
+            shared.n_verts = n_verts
+            shared.n_edges = n_edges
+            shared.n_faces = n_faces
+            shared.n_corners = n_corners
+            shared.verts = <void*>&verts_mv[v_cursor * 3] if n_verts else NULL
+            shared.edges = <void*>&edges_mv[e_cursor * 2] if n_edges else NULL
+            shared.loop_starts = <void*>&lbases_mv[lb_cursor] if n_faces else NULL
+            shared.corner_verts = <void*>&loops_mv[l_cursor] if n_corners else NULL
+            _shared_meshes[mesh_key] = shared
 
-    print("create_data_arrays.loop.foreach_get_loop_start: ", timers.get_elapsed_ms("create_data_arrays.loop.foreach_get_loop_start"), "ms")
-    timers.reset("create_data_arrays.loop.foreach_get_loop_start")
+            if proxy is not None:
+                if n_verts:
+                    _queue_copy(&_copy_tasks, proxy.data.positions.data(), shared.verts, n_verts * 3 * sizeof(float))
+                if n_edges:
+                    _queue_copy(&_copy_tasks, proxy.data.edges.data(), shared.edges, n_edges * 2 * sizeof(int))
+                if n_faces:
+                    _queue_copy(&_copy_tasks, proxy.data.loop_starts.data(), shared.loop_starts, n_faces * sizeof(uint32_t))
+                if n_corners:
+                    _queue_copy(&_copy_tasks, proxy.data.corner_verts.data(), shared.corner_verts, n_corners * sizeof(int))
+                v_cursor += n_verts
+                e_cursor += n_edges
+                lb_cursor += n_faces
+                l_cursor += n_corners
+                continue
 
-    print("create_data_arrays.loop.foreach_get_loops: ", timers.get_elapsed_ms("create_data_arrays.loop.foreach_get_loops"), "ms")
-    timers.reset("create_data_arrays.loop.foreach_get_loops")
+            if n_verts:
+                position_data = mesh.attributes["position"].data
+                if not (parallel and _queue_raw_copy(&_copy_tasks, position_data, &verts_mv[v_cursor * 3], n_verts * 3 * sizeof(float))):
+                    position_data.foreach_get("vector", verts_mv[v_cursor * 3:v_cursor * 3 + n_verts * 3])
+            v_cursor += n_verts
 
+            if n_edges:
+                edge_data = mesh.attributes[".edge_verts"].data
+                if not (parallel and _queue_raw_copy(&_copy_tasks, edge_data, &edges_mv[e_cursor * 2], n_edges * 2 * sizeof(int))):
+                    edge_data.foreach_get("value", edges_mv[e_cursor * 2:e_cursor * 2 + n_edges * 2])
+            e_cursor += n_edges
 
-    print ("create_data_arrays.loop: ", timers.stop("data_arrays.loop"), "ms")
-    timers.reset("data_arrays.loop")
-    
-    return shm_context
\ No newline at end of file
+            if n_faces:
+                polygons = mesh.polygons
+                if not (parallel and _queue_raw_copy(&_copy_tasks, polygons, &lbases_mv[lb_cursor], n_faces * sizeof(uint32_t))):
+                    polygons.foreach_get("loop_start", lbases_mv[lb_cursor:lb_cursor + n_faces])
+            lb_cursor += n_faces
+
+            if n_corners:
+                corner_data = mesh.attributes[".corner_vert"].data
+                if not (parallel and _queue_raw_copy(&_copy_tasks, corner_data, &loops_mv[l_cursor], n_corners * sizeof(int))):
+                    corner_data.foreach_get("value", loops_mv[l_cursor:l_cursor + n_corners])
+            l_cursor += n_corners
+        profiler.end(STAGE_GEOMETRY, t0)
+
+        # Sentinel totals (bases length = object_count + 1)
+        vcount_mv[len(group.objects)] = v_cursor
+        ecount_mv[len(group.objects)] = e_cursor
+        obj_loop_counts_mv[len(group.objects)] = lb_cursor
+        profiler.end(STAGE_GROUP, t_group)
+
+    # Every group's shm regions are disjoint, so the queued copies can run in any order
+    t0 = profiler.begin()
+    if not _copy_tasks.empty():
+        with nogil:
+            run_copy_tasks(_copy_tasks.data(), _copy_tasks.size(), 0)
+    _copy_tasks.clear()
+    profiler.end(STAGE_PARALLEL_COPY, t0)
+
+    # Duplicates read the first copies, so they run once those are in place
+    t0 = profiler.begin()
+    if not _dup_tasks.empty():
+        with nogil:
+            run_copy_tasks(_dup_tasks.data(), _dup_tasks.size(), 0)
+    _dup_tasks.clear()
+    _shared_meshes.clear()
+    profiler.end(STAGE_DUPLICATE_COPY, t0)
+
+    if truncated_names:
+        print(f"[Pivot] {truncated_names} object names exceed {MAX_NAME_LEN} bytes and were shortened in the upload")
+    if proxied_objects:
+        print(f"[Pivot] Uploaded {proxied_objects} objects as proxies of at most {proxy_vertex_budget} vertices")
+    if deduped_objects:
+        print(f"[Pivot] {deduped_objects} objects share mesh data and were copied from their first instance")
+
+    return shm_context
@@ -23,11 +23,9 @@
 # - Managing collection hierarchy for surface type classification (Pro edition)
 
 import bpy
-import json
 
-from . import selection_utils, shm_utils, edition_utils
-from .timer_manager import timers
-from . import id_manager, surface_manager
+from . import selection_utils, shm_utils, edition_utils, job_queue
+from . import id_manager, surface_manager, profiler
 
 
 # Collection metadata keys
@@ -35,6 +33,18 @@ GROUP_COLLECTION_PROP = "pivot_group_name"
 CLASSIFICATION_ROOT_COLLECTION_NAME = "Pivot"
 CLASSIFICATION_COLLECTION_PROP = "pivot_surface_type"
 
+# Vertex budget per streamed chunk; big enough to amortize shm setup, small
+# enough that the first chunk reaches the engine early
+PIPELINE_CHUNK_VERTS = 2_000_000
+
+cdef int STAGE_AGGREGATE = profiler.stage_id("standardize.aggregate_object_groups")
+cdef int STAGE_EVALUATE = profiler.stage_id("standardize.evaluate_objects")
+cdef int STAGE_UPLOAD = profiler.stage_id("standardize.create_data_arrays")
+cdef int STAGE_WAIT = profiler.stage_id("standardize.wait_for_engine")
+
+# Context sent for AUTO groups the engine has not classified yet
+cdef int UNCLASSIFIED_SURFACE_CONTEXT = 3
+
 def _build_group_surface_contexts(asset_uuids, surface_context):
     """Build per-group surface context strings, honoring AUTO overrides with stored classifications."""
 
@@ -44,86 +54,183 @@ def _build_group_surface_contexts(asset_uuids, surface_context):
     contexts = []
     auto_context = surface_context == "AUTO"
     if auto_context:
-        map_to_use = surface_manager.collect_group_classifications()
-
-        if not map_to_use:
-            return [3] * len(asset_uuids)
-
-        for uuid in asset_uuids:
-            if uuid in map_to_use:
-                surface_type_int = map_to_use[uuid]
-                if surface_type_int in (1, 2, 3):
-                    contexts.append(surface_type_int)
-                else:
-                    contexts.append(0)
+        # One lookup per requested asset in the cached classification map
+        for surface_type_int in surface_manager.get_group_surface_types(list(asset_uuids)):
+            if surface_type_int is None:
+                contexts.append(UNCLASSIFIED_SURFACE_CONTEXT)
+            elif surface_type_int in (1, 2, 3):
+                contexts.append(surface_type_int)
+            else:
+                contexts.append(0)
 
         return contexts
     else:
         return [int(surface_context)] * len(asset_uuids)
 
-def standardize_groups(list selected_objects, str origin_method, str surface_context):
-    """Pro Edition: Classify selected groups via engine."""
+def _filter_dirty_groups(list mesh_groups, list group_names, list asset_uuids):
+    """Drop groups the engine already holds up-to-date results for.
+
+    A group is skipped when its asset is current (synced, and no member changed
+    revision since the last upload); the geometry signature is compared as well
+    as a cheap guard against membership changes the revisions cannot see.
+
+    Returns mesh_groups, group_names, asset_uuids, signatures for the dirty groups.
+    """
+    cdef list dirty_groups = []
+    cdef list dirty_names = []
+    cdef list dirty_uuids = []
+    cdef list signatures = []
+    cdef Py_ssize_t i
+
+    for i in range(len(mesh_groups)):
+        signature = shm_utils.group_signature(mesh_groups[i])
+        uuid = asset_uuids[i]
+        if id_manager.is_asset_current(uuid) and id_manager.get_upload_signature(uuid) == signature:
+            continue
+        dirty_groups.append(mesh_groups[i])
+        dirty_names.append(group_names[i])
+        dirty_uuids.append(uuid)
+        signatures.append(signature)
+
+    return dirty_groups, dirty_names, dirty_uuids, signatures
+
+def _resolve_precision(int precision):
+    """Fall back to full precision when the engine cannot take the requested one."""
+    if shm_utils.supports_precision(precision):
+        return precision
+    print(f"[Pivot] Engine does not support upload precision {precision}; sending full precision")
+    return shm_utils.PRECISION_FULL
+
+def submit_standardize_groups(list selected_objects, str origin_method, str surface_context, bint dirty_only=True, bint streaming=True, bint object_names=True, Py_ssize_t proxy_vertex_budget=0, bint base_meshes=True, int precision=shm_utils.PRECISION_FULL):
+    """Pro Edition: Upload selected groups and queue their classification without blocking.
+
+    With dirty_only and an AUTO surface context, groups that are already synced
+    with the engine are not uploaded again; groups whose members have not
+    changed geometry since their last upload are not even evaluated. Explicit
+    surface overrides always re-send every group since they change the
+    engine's answer.
+
+    With streaming, groups are uploaded in chunks of roughly PIPELINE_CHUNK_VERTS
+    vertices, each queued as soon as it is written.
+
+    Without object_names, name slots are left empty; results are matched by UUID.
+
+    A positive proxy_vertex_budget uploads objects denser than that as bounded
+    proxies (see shm_utils.create_data_arrays).
 
-    timers.start("standardize_groups.aggregate_object_groups")
-    mesh_groups, group_names, collections = selection_utils.aggregate_object_groups(selected_objects)
-    print("standardize_groups.aggregate_object_groups: ", timers.stop("standardize_groups.aggregate_object_groups"), "ms")
-    timers.reset("standardize_groups.aggregate_object_groups")
+    With base_meshes, objects without modifiers or shape keys skip depsgraph
+    evaluation (see selection_utils.aggregate_object_groups).
 
-    if collections:
-        asset_uuids = id_manager.get_or_create_asset_uuid(collections)
+    precision picks a shm_utils.PRECISION_* mode for the request; engines
+    without support for it get full precision.
 
-        surface_contexts = _build_group_surface_contexts(asset_uuids, surface_context)
+    Returns the list of job_queue.StandardizeJob handles (empty when there was
+    nothing to send). Results are applied by the sync timer in completion order.
+    """
+
+    # Summaries cover this call only
+    profiler.reset()
+    cdef long long t0 = profiler.begin()
+    cdef bint reuse_synced = dirty_only and surface_context == "AUTO"
+    mesh_groups, group_names, collections = selection_utils.aggregate_object_groups(selected_objects, skip_current=reuse_synced, base_meshes=base_meshes)
+    profiler.end(STAGE_AGGREGATE, t0)
+
+    if not collections:
+        return []
 
-        context = shm_utils.create_data_arrays(mesh_groups, group_names, asset_uuids, surface_contexts)
+    asset_uuids = id_manager.get_or_create_asset_uuid(collections)
 
-        timers.start("engine.compute")
-        try:
-            print("Starting finalize")
-            final_json = context.finalize(True)
-            print("Ending finalize")
-        except Exception as e:
-            print ("BIG ERROR")
-            print(e)
-        final_response = json.loads('{"ok": true }')
-        
-        print("engine.compute: ", timers.stop("engine.compute"), "ms")
-        timers.reset("engine.compute")
+    if reuse_synced:
+        mesh_groups, group_names, asset_uuids, signatures = _filter_dirty_groups(mesh_groups, group_names, asset_uuids)
+    else:
+        signatures = [shm_utils.group_signature(group) for group in mesh_groups]
+
+    if not mesh_groups:
+        print("[Pivot] All selected groups are already synced with the engine")
+        return []
 
-def _get_standardize_results(list objects, str surface_context="AUTO"):
+    surface_contexts = _build_group_surface_contexts(asset_uuids, surface_context)
+    precision = _resolve_precision(precision)
+
+    cdef list jobs = []
+    cdef Py_ssize_t start = 0
+    cdef Py_ssize_t end
+    cdef Py_ssize_t chunk_verts
+    cdef Py_ssize_t num_groups = len(mesh_groups)
+
+    # Streaming: seal and queue each chunk as soon as it is filled, so the worker
+    # computes chunk N while chunk N+1 is being copied into shm
+    while start < num_groups:
+        end = start
+        chunk_verts = 0
+        while end < num_groups and (end == start or not streaming or chunk_verts < PIPELINE_CHUNK_VERTS):
+            chunk_verts += signatures[end][1] if proxy_vertex_budget <= 0 else mesh_groups[end].upload_verts(proxy_vertex_budget)
+            end += 1
+
+        chunk_uuids = asset_uuids[start:end]
+        t0 = profiler.begin()
+        context = shm_utils.create_data_arrays(mesh_groups[start:end], group_names[start:end], chunk_uuids, surface_contexts[start:end], write_names=object_names, proxy_vertex_budget=proxy_vertex_budget, precision=precision)
+        profiler.end(STAGE_UPLOAD, t0)
+
+        for i in range(start, end):
+            id_manager.set_upload_signature(asset_uuids[i], signatures[i], mesh_groups[i].originals())
+        jobs.append(job_queue.submit(context, True, chunk_uuids))
+        start = end
+
+    if len(jobs) > 1:
+        print(f"[Pivot] Streamed {num_groups} groups to the engine in {len(jobs)} chunks")
+    profiler.print_summary()
+    return jobs
+
+def standardize_groups(list selected_objects, str origin_method, str surface_context, bint dirty_only=True, Py_ssize_t proxy_vertex_budget=0):
+    """Pro Edition: Classify selected groups via engine, blocking until the engine is done."""
+    jobs = submit_standardize_groups(selected_objects, origin_method, surface_context, dirty_only, proxy_vertex_budget=proxy_vertex_budget)
+    _wait_for_engine(jobs)
+    return jobs
+
+def _wait_for_engine(jobs):
+    """Block until jobs (one job, a list, or None) left the engine; raise if the engine reported an error."""
+    if jobs is None:
+        return
+    if not isinstance(jobs, list):
+        jobs = [jobs]
+
+    cdef long long t0 = profiler.begin()
+    for job in jobs:
+        job.wait_finalized()
+    profiler.end(STAGE_WAIT, t0)
+
+    for job in jobs:
+        if job.state == job_queue.JOB_FAILED:
+            raise RuntimeError(f"standardize failed: {job.error}")
+
+def _submit_standardize_objects(list objects, str surface_context="AUTO", Py_ssize_t proxy_vertex_budget=0, bint base_meshes=True, int precision=shm_utils.PRECISION_FULL):
     """
-    Helper function to get standardization results from the engine.
-        
-    Returns mesh_objects, rots, origins, cogs
+    Upload objects as single-object groups and queue them on the engine.
+
+    Objects without modifiers or shape keys upload their base mesh unless
+    base_meshes is off (see selection_utils.aggregate_object_groups).
+    precision is handled as in submit_standardize_groups.
+
+    Returns a job_queue.StandardizeJob, or None when no object had geometry.
     """
     if not objects:
-        return [], [], [], []
+        return None
     
     # Validation: STANDARD edition only supports single object
     if len(objects) > 1 and not edition_utils.is_pro_edition():
         raise RuntimeError(f"STANDARD edition only supports single object classification, got {len(objects)}")
     
-    timers.start("get_standardize_results.depsgraph")
-
-    depsgraph = bpy.context.evaluated_depsgraph_get()
-    mesh_groups = []
-    group_names = []
-    targets = []
-    for obj in objects:
-        eval_obj = obj.evaluated_get(depsgraph)
-        eval_mesh = eval_obj.data
-        eval_verts = eval_mesh.vertices
-        eval_edges = eval_mesh.edges
-        if len(eval_verts) == 0:
-            continue
-        mesh_groups.append([(eval_obj, eval_mesh, eval_verts, eval_edges, eval_mesh.loops, eval_mesh.polygons)])
-        group_names.append(obj.name)
-        targets.append(obj)
+    profiler.reset()
+    cdef long long t0 = profiler.begin()
+
+    mesh_groups, targets = selection_utils.mesh_groups_for_objects(objects, base_meshes)
+    group_names = [obj.name for obj in targets]
     
-    print("get_standardize_results.depsgraph: ", timers.stop("get_standardize_results.depsgraph"), "ms")
-    timers.reset("get_standardize_results.depsgraph")
+    profiler.end(STAGE_EVALUATE, t0)
 
     if not mesh_groups:
-        return [], [], [], []
+        return None
     # Map surface_context to engine-expected string
     if surface_context in ("0", "1", "2"):
         engine_surface_context = int(surface_context)
@@ -131,46 +238,35 @@ def _get_standardize_results(list objects, str surface_context="AUTO"):
         engine_surface_context = 0
     surface_contexts = [engine_surface_context] * len(mesh_groups)
 
+    target_uuids = id_manager.get_or_create_obj_uuids(targets)
 
-    timers.start("create_data_arrays.total")
+    t0 = profiler.begin()
     context = shm_utils.create_data_arrays(
         mesh_groups,
         group_names,
-        id_manager.get_or_create_obj_uuids(targets),
-        surface_contexts
+        target_uuids,
+        surface_contexts,
+        proxy_vertex_budget=proxy_vertex_budget,
+        precision=_resolve_precision(precision),
     )
-    print("create_data_arrays.total: ", timers.stop("create_data_arrays.total"), "ms")
-    timers.reset("create_data_arrays.total")
-
-
-    timers.start("engine.compute")
-    try:
-        print("Starting finalize")
-        final_json = context.finalize(False)
-        print("Ending finalize")
-    except Exception as e:
-        print ("BIG ERROR")
-        print(e)
-    final_response = json.loads('{"ok": true }')
-    
-    print("engine.compute: ", timers.stop("engine.compute"), "ms")
-    timers.reset("engine.compute")
-
+    profiler.end(STAGE_UPLOAD, t0)
+    profiler.print_summary()
 
+    return job_queue.submit(context, False, target_uuids)
 
-    timers.start("set_origin_selected_objects.underhead")
-    
-    if not bool(final_response.get("ok", True)):
-        error_msg = final_response.get("error", "Unknown engine error during standardize_groups")
-        raise RuntimeError(f"standardize_groups failed: {error_msg}")
-
+def submit_standardize_object_origins(list objects, str origin_method, str surface_context="AUTO", Py_ssize_t proxy_vertex_budget=0, int precision=shm_utils.PRECISION_FULL):
+    """Queue an origin standardization and return its job handle without blocking."""
+    return _submit_standardize_objects(objects, surface_context, proxy_vertex_budget, precision=precision)
 
+def submit_standardize_object_rotations(list objects, Py_ssize_t proxy_vertex_budget=0, int precision=shm_utils.PRECISION_FULL):
+    """Queue a rotation standardization and return its job handle without blocking."""
+    return _submit_standardize_objects(objects, proxy_vertex_budget=proxy_vertex_budget, precision=precision)
 
-def standardize_object_origins(list objects, str origin_method, str surface_context="AUTO"):
+def standardize_object_origins(list objects, str origin_method, str surface_context="AUTO", Py_ssize_t proxy_vertex_budget=0):
     """Standardize object origins."""
-    _get_standardize_results(objects, surface_context)
+    _wait_for_engine(submit_standardize_object_origins(objects, origin_method, surface_context, proxy_vertex_budget))
     
 
-def standardize_object_rotations(list objects):
+def standardize_object_rotations(list objects, Py_ssize_t proxy_vertex_budget=0):
     """Standardize object rotations."""
-    _get_standardize_results(objects)
\ No newline at end of file
+    _wait_for_engine(submit_standardize_object_rotations(objects, proxy_vertex_budget))
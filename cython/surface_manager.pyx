@@ -35,6 +35,16 @@ CLASSIFICATION_ROOT_MARKER_PROP = "pivot_is_classification_root"
 CLASSIFICATION_COLLECTION_PROP = "pivot_surface_type"
 CLASSIFICATION_MARKER_PROP = "pivot_is_classification_collection"
 
+# Cached classification layout: the root, its surface buckets and which bucket
+# each asset sits in. Built from the real hierarchy (with structure
+# enforcement) when missing or stale, then kept current by the organizer.
+# The collection handlers drop it when a user edits the classification tree.
+cdef object _cached_root = None
+cdef dict _bucket_by_key = {}    # surface key -> bucket collection
+cdef dict _group_surface = {}    # asset uuid -> surface key
+cdef bint _cache_valid = False
+cdef bint _cache_enforced = False # built through _get_and_enforce_root_collection
+
 
 def _get_surface_display_name(str surface_key) -> str:
     """Get the display name for a surface key."""
@@ -77,6 +87,78 @@ def _get_and_enforce_root_collection():
     
     return pivot_root
 
+def invalidate_surface_cache() -> None:
+    """Forget the cached classification layout; the next organize rebuilds it."""
+    global _cached_root, _cache_valid, _cache_enforced
+    _cached_root = None
+    _cache_valid = False
+    _cache_enforced = False
+    _bucket_by_key.clear()
+    _group_surface.clear()
+
+
+cdef bint _cache_alive():
+    """Cheap staleness check: the cached root and buckets still exist and are still marked."""
+    if not _cache_valid:
+        return False
+    if _cached_root is None:
+        return True  # Read-only lookup found no root; the next organize enforces one
+    try:
+        if not _cached_root.get(CLASSIFICATION_ROOT_MARKER_PROP, False):
+            return False
+        for bucket in _bucket_by_key.values():
+            if not bucket.get(CLASSIFICATION_MARKER_PROP, False):
+                return False
+    except ReferenceError:
+        return False
+    return True
+
+
+cdef object _find_root_collection():
+    """Locate the classification root without creating or changing anything."""
+    for coll in bpy.data.collections:
+        if coll.get(CLASSIFICATION_ROOT_MARKER_PROP, False):
+            return coll
+    return None
+
+
+cdef object _ensure_surface_cache(bint enforce):
+    """Return the classification root, rebuilding the cached layout if it went stale.
+
+    With enforce, a rebuild goes through _get_and_enforce_root_collection;
+    without it (lookup paths) the hierarchy is only read.
+    """
+    global _cached_root, _cache_valid, _cache_enforced
+    if _cache_alive() and (_cache_enforced or not enforce):
+        return _cached_root
+
+    invalidate_surface_cache()
+    if enforce:
+        pivot_root = _get_and_enforce_root_collection()
+    else:
+        pivot_root = _find_root_collection()
+    if not pivot_root:
+        _cache_valid = not enforce
+        return None
+
+    if enforce:
+        pivot_root[CLASSIFICATION_ROOT_MARKER_PROP] = True
+    for bucket in pivot_root.children:
+        surface_key = bucket.get(CLASSIFICATION_COLLECTION_PROP)
+        if not surface_key:
+            continue
+        _bucket_by_key[surface_key] = bucket
+        for group_coll in bucket.children:
+            uuid = group_coll.get(id_manager.PIVOT_ASSET_ID)
+            if uuid:
+                _group_surface[bytes(uuid)] = surface_key
+
+    _cached_root = pivot_root
+    _cache_valid = True
+    _cache_enforced = enforce
+    return pivot_root
+
+
 def get_or_create_surface_collection(pivot_root, str surface_key):
     """Get or create a surface classification collection."""
     if not pivot_root:
@@ -105,25 +187,30 @@ def get_or_create_surface_collection(pivot_root, str surface_key):
     return surface_coll
 
 def collect_group_classifications() -> dict:
-    """Collect group -> surface type mappings."""
+    """Collect group -> surface type mappings for all tracked assets."""
     cdef dict result = {}
-    pivot_root = _get_and_enforce_root_collection()
-    if not pivot_root:
-        return result
-
-    for surface_coll in pivot_root.children:
-        surface_value = surface_coll.get(CLASSIFICATION_COLLECTION_PROP)
-        if surface_value:
-            try:
-                surface_int = int(surface_value)
-            except (TypeError, ValueError):
-                continue
+    _ensure_surface_cache(False)
+
+    for uuid, surface_key in _group_surface.items():
+        if not id_manager.has_asset(uuid):
+            continue
+        try:
+            result[uuid] = int(surface_key)
+        except (TypeError, ValueError):
+            continue
 
-            for group_coll in surface_coll.children:
-                uuid = group_coll.get(id_manager.PIVOT_ASSET_ID)
-                if id_manager.has_asset(uuid):
-                    result[uuid] = surface_int
+    return result
 
+def get_group_surface_types(list uuids) -> list:
+    """Stored surface type per asset uuid (None where unclassified), without enforcing structure."""
+    _ensure_surface_cache(False)
+    cdef list result = []
+    for uuid in uuids:
+        surface_key = _group_surface.get(uuid)
+        try:
+            result.append(int(surface_key) if surface_key is not None else None)
+        except (TypeError, ValueError):
+            result.append(None)
     return result
 
 def sync_group_classifications(dict group_surface_map) -> bool:
@@ -157,22 +244,65 @@ def organize_group_into_surface(group_collection, str surface_key, pivot_root) -
     if surface_coll.children.find(group_collection.name) == -1:
         collection_manager.ensure_collection_link(surface_coll, group_collection)
 
-def organize_groups_into_surfaces(unsigned char[:, :] asset_uuids, unsigned short[:] surface_types) -> None:
-    """Organize multiple group collections into the surface hierarchy using parallel lists."""
+    uuid = group_collection.get(id_manager.PIVOT_ASSET_ID)
+    if _cache_valid and uuid:
+        _group_surface[bytes(uuid)] = surface_key
+
+def organize_groups_into_surfaces(const unsigned char[:, :] asset_uuids, const unsigned short[:] surface_types) -> None:
+    """Move every returned group into its surface bucket, touching only groups whose bucket changed.
+
+    Works from the cached group -> surface map, so each group costs at most one
+    unlink and one link regardless of how many groups are already organized.
+    """
     cdef Py_ssize_t num_uuids = asset_uuids.shape[0]
-    cdef Py_ssize_t i
+    if num_uuids == 0:
+        return
 
-    # Get and enforce the root collection (includes cleanup)
-    pivot_root = _get_and_enforce_root_collection()
-    
-    cdef int idx
+    # Get the root (structure is enforced only when the cache is rebuilt)
+    pivot_root = _ensure_surface_cache(True)
+    if not pivot_root:
+        return
+
+    cdef Py_ssize_t idx
+    cdef Py_ssize_t moved = 0
     cdef str surface_key
-    
+    cdef object current_key
+    cdef bytes uuid
+    cdef list group_colls = id_manager.get_assets_from_view(asset_uuids)
+
     for idx in range(num_uuids):
-        group_coll = id_manager.get_asset_by_uuid([bytes(asset_uuids[idx])])[0]
-        
+        group_coll = group_colls[idx]
         surface_key = str(surface_types[idx])
-        organize_group_into_surface(group_coll, surface_key, pivot_root)
+        uuid = bytes(asset_uuids[idx])
+        current_key = _group_surface.get(uuid)
+        if current_key == surface_key:
+            continue
+
+        bucket = _bucket_by_key.get(surface_key)
+        if bucket is None:
+            bucket = get_or_create_surface_collection(pivot_root, surface_key)
+            if not bucket:
+                continue
+            _bucket_by_key[surface_key] = bucket
+
+        # Unlink from its previous surface container FIRST
+        if current_key is not None:
+            previous = _bucket_by_key.get(current_key)
+            if previous is not None:
+                try:
+                    previous.children.unlink(group_coll)
+                except RuntimeError:
+                    pass
+
+        try:
+            bucket.children.link(group_coll)
+        except RuntimeError:
+            pass  # Already linked (the cache had not seen it yet)
+        _group_surface[uuid] = surface_key
+        moved += 1
+
+    if moved:
+        print(f"[Pivot] Reorganized {moved} of {num_uuids} groups into surface collections")
 
 cpdef bint is_classification_collection(collection):
     """Check if a collection is a classification collection."""
@@ -0,0 +1,227 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+# transform_utils.pyx - Bulk world-matrix access for Blender objects
+#
+# Reading matrix_world through mathutils costs one Python round trip per
+# element. Here every object's matrix is read with a single foreach_get on
+# bpy.data.objects and then gathered per request in C.
+
+import bpy
+import array
+from cpython cimport array
+from cython.operator cimport dereference as deref
+from libc.math cimport fabsf
+from libc.stdint cimport uint32_t
+from libc.string cimport memcmp, memcpy
+from libcpp.unordered_map cimport unordered_map
+from libcpp.vector cimport vector
+
+# The bulk read covers the whole scene, so it only pays off once a request
+# touches at least 1 / BULK_TRANSFORM_RATIO of bpy.data.objects.
+cdef Py_ssize_t BULK_TRANSFORM_RATIO = 8
+
+# Grow-only scratch buffers reused across calls, so repeated small standardize
+# and sync passes do not allocate (and page-fault) fresh arrays every time.
+# Contents are only valid until the next request for the same buffer.
+cdef array.array _scratch_floats = array.array('f')
+cdef array.array _scratch_ints = array.array('i')
+cdef array.array _scratch_matrices = array.array('f')  # backs the latest SceneTransforms
+cdef unsigned long long _matrices_generation = 0       # bumped by every snapshot
+
+
+cdef array.array _grow(array.array buf, Py_ssize_t n):
+    cdef Py_ssize_t size = len(buf)
+    if size < n:
+        array.resize(buf, max(n, size * 2))
+    return buf
+
+
+def scratch_floats(Py_ssize_t n) -> array.array:
+    """Shared float scratch array holding at least n items (main thread only)."""
+    return _grow(_scratch_floats, n)
+
+
+def should_bulk_read(Py_ssize_t num_objects) -> bool:
+    """Whether a SceneTransforms snapshot is cheaper than per-object reads."""
+    return num_objects > 0 and num_objects * BULK_TRANSFORM_RATIO >= len(bpy.data.objects)
+
+
+cdef class SceneTransforms:
+    """Snapshot of every object's matrix_world.
+
+    Matrices are kept exactly as foreach_get returns them: 16 floats per object
+    in Blender's column-major order, which is also the shm transform layout, so
+    gathering a group is one 64-byte copy per object. The matrices live in a
+    shared scratch buffer, so only the most recent snapshot may be gathered
+    from; gather raises on an older one.
+    """
+    cdef unordered_map[uint32_t, Py_ssize_t] _index
+    cdef array.array _matrices
+    cdef unsigned long long _generation
+
+    def __cinit__(self):
+        global _matrices_generation
+        _matrices_generation += 1
+        self._generation = _matrices_generation
+        objects = bpy.data.objects
+        cdef Py_ssize_t count = len(objects)
+        cdef array.array session_uids = _grow(_scratch_ints, count)
+        cdef Py_ssize_t i
+
+        self._matrices = _grow(_scratch_matrices, count * 16)
+        if count == 0:
+            return
+
+        objects.foreach_get("session_uid", memoryview(session_uids)[:count])
+        objects.foreach_get("matrix_world", memoryview(self._matrices)[:count * 16])
+
+        self._index.reserve(count)
+        for i in range(count):
+            self._index[<uint32_t>session_uids.data.as_ints[i]] = i
+
+    def gather(self, list objs, float[::1] out) -> bool:
+        """Copy the matrices of objs (originals) into out, 16 floats each.
+
+        Returns False if any object is missing from the snapshot; out is then
+        only partially written and the caller should fall back to per-object reads.
+        """
+        cdef Py_ssize_t num_objs = len(objs)
+        cdef Py_ssize_t i
+        cdef unordered_map[uint32_t, Py_ssize_t].iterator it
+        cdef const float* matrices = self._matrices.data.as_floats
+
+        if self._generation != _matrices_generation:
+            raise RuntimeError("SceneTransforms snapshot was superseded by a newer one")
+        if out.shape[0] < num_objs * 16:
+            raise ValueError(f"transform buffer holds {out.shape[0] // 16} matrices but {num_objs} objects were given")
+
+        for i in range(num_objs):
+            it = self._index.find(<uint32_t>objs[i].session_uid)
+            if it == self._index.end():
+                return False
+            memcpy(&out[i * 16], &matrices[deref(it).second * 16], 16 * sizeof(float))
+        return True
+
+
+cdef void _read_matrix(object obj, float* outp):
+    """Per-object fallback: write matrix_world column-major, caching rows to reduce Python lookups."""
+    mat = obj.matrix_world
+    r0 = mat[0]
+    r1 = mat[1]
+    r2 = mat[2]
+    r3 = mat[3]
+    outp[0] = <float>r0[0]
+    outp[1] = <float>r1[0]
+    outp[2] = <float>r2[0]
+    outp[3] = <float>r3[0]
+    outp[4] = <float>r0[1]
+    outp[5] = <float>r1[1]
+    outp[6] = <float>r2[1]
+    outp[7] = <float>r3[1]
+    outp[8] = <float>r0[2]
+    outp[9] = <float>r1[2]
+    outp[10] = <float>r2[2]
+    outp[11] = <float>r3[2]
+    outp[12] = <float>r0[3]
+    outp[13] = <float>r1[3]
+    outp[14] = <float>r2[3]
+    outp[15] = <float>r3[3]
+
+
+def read_matrices(list objs, float[::1] out, SceneTransforms snapshot=None) -> None:
+    """Fill out with the column-major matrix_world of every object, 16 floats each.
+
+    Uses snapshot when one is given and covers every object, else reads per object.
+    """
+    cdef Py_ssize_t num_objs = len(objs)
+    cdef Py_ssize_t i
+
+    if out.shape[0] < num_objs * 16:
+        raise ValueError(f"transform buffer holds {out.shape[0] // 16} matrices but {num_objs} objects were given")
+    if snapshot is not None and snapshot.gather(objs, out):
+        return
+    for i in range(num_objs):
+        _read_matrix(objs[i], &out[i * 16])
+
+
+cdef class TransformCache:
+    """Last seen world matrix per object, for change detection in depsgraph handlers.
+
+    Matrices are stored packed (16 floats, column-major) in one contiguous
+    buffer, keyed by session_uid. A bitwise compare catches the common
+    unchanged case before the epsilon check.
+    """
+    cdef unordered_map[uint32_t, size_t] _slots
+    cdef vector[float] _matrices
+    cdef vector[size_t] _free  # slots released by forget()
+    cdef float _epsilon
+
+    def __cinit__(self, float epsilon=1e-6):
+        self._epsilon = epsilon
+
+    def __len__(self):
+        return self._slots.size()
+
+    def update(self, obj) -> bool:
+        """Store obj's current matrix; True if it differs from the previously stored one.
+
+        The first observation of an object only records it and returns False.
+        """
+        cdef float current[16]
+        cdef float* stored
+        cdef Py_ssize_t j
+        cdef size_t slot
+        cdef uint32_t key = <uint32_t>obj.session_uid
+        cdef unordered_map[uint32_t, size_t].iterator it = self._slots.find(key)
+
+        _read_matrix(obj, current)
+
+        if it == self._slots.end():
+            if not self._free.empty():
+                slot = self._free.back()
+                self._free.pop_back()
+            else:
+                slot = self._matrices.size()
+                self._matrices.resize(slot + 16)
+            memcpy(&self._matrices[slot], current, 16 * sizeof(float))
+            self._slots[key] = slot
+            return False
+
+        stored = &self._matrices[deref(it).second]
+        if memcmp(stored, current, 16 * sizeof(float)) == 0:
+            return False
+
+        cdef bint changed = False
+        for j in range(16):
+            if fabsf(stored[j] - current[j]) > self._epsilon:
+                changed = True
+                break
+        memcpy(stored, current, 16 * sizeof(float))
+        return changed
+
+    def forget(self, uint32_t session_uid) -> None:
+        """Stop tracking an object by session_uid (it may already be deleted); its slot is handed to the next new object."""
+        cdef unordered_map[uint32_t, size_t].iterator it = self._slots.find(session_uid)
+        if it != self._slots.end():
+            self._free.push_back(deref(it).second)
+            self._slots.erase(it)
+
+    def clear(self) -> None:
+        self._slots.clear()
+        self._matrices.clear()
+        self._free.clear()
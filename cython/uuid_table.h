@@ -0,0 +1,257 @@
+// Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+// This file is part of the Pivot Bridge for Blender.
+
+// The Pivot Bridge for Blender is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <https://www.gnu.org/licenses>.
+
+// uuid_table.h - Native storage behind id_manager.pyx.
+//
+// UuidTable maps 128-bit UUIDs to record slots with open addressing, so
+// lookups hash the 16 raw bytes straight out of shm views instead of
+// allocating Python bytes keys. CsrLists keeps one variable-length int list
+// per record (asset -> member objects, object -> parent assets) in a single
+// pool, compacting when more than half of it is dead.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace pivot_bridge {
+
+struct Uuid128 {
+    unsigned char data[16];
+};
+
+inline std::uint64_t uuid_hash(const unsigned char* key) {
+    std::uint64_t lo;
+    std::uint64_t hi;
+    std::memcpy(&lo, key, 8);
+    std::memcpy(&hi, key + 8, 8);
+    // UUIDs are already random; one multiply-xorshift round spreads both halves
+    std::uint64_t h = lo ^ (hi * 0x9E3779B97F4A7C15ull);
+    h ^= h >> 32;
+    h *= 0xD6E8FEB86659FD93ull;
+    h ^= h >> 32;
+    return h;
+}
+
+class UuidTable {
+public:
+    // Slot stored for key, or -1.
+    std::int32_t find(const unsigned char* key) const {
+        if (slots_.empty()) {
+            return -1;
+        }
+        std::size_t mask = slots_.size() - 1;
+        for (std::size_t i = uuid_hash(key) & mask;; i = (i + 1) & mask) {
+            const Slot& slot = slots_[i];
+            if (slot.state == kEmpty) {
+                return -1;
+            }
+            if (slot.state == kFull && std::memcmp(slot.key, key, 16) == 0) {
+                return slot.value;
+            }
+        }
+    }
+
+    // Insert or overwrite.
+    void insert(const unsigned char* key, std::int32_t value) {
+        if ((used_ + 1) * 4 > slots_.size() * 3) {
+            rehash(size_ * 2 + 16);
+        }
+        std::size_t mask = slots_.size() - 1;
+        std::size_t target = SIZE_MAX;
+        for (std::size_t i = uuid_hash(key) & mask;; i = (i + 1) & mask) {
+            Slot& slot = slots_[i];
+            if (slot.state == kEmpty) {
+                if (target == SIZE_MAX) {
+                    target = i;
+                    ++used_;
+                }
+                break;
+            }
+            if (slot.state == kTombstone) {
+                if (target == SIZE_MAX) {
+                    target = i;
+                }
+            } else if (std::memcmp(slot.key, key, 16) == 0) {
+                slot.value = value;
+                return;
+            }
+        }
+        Slot& slot = slots_[target];
+        std::memcpy(slot.key, key, 16);
+        slot.value = value;
+        slot.state = kFull;
+        ++size_;
+    }
+
+    bool erase(const unsigned char* key) {
+        if (slots_.empty()) {
+            return false;
+        }
+        std::size_t mask = slots_.size() - 1;
+        for (std::size_t i = uuid_hash(key) & mask;; i = (i + 1) & mask) {
+            Slot& slot = slots_[i];
+            if (slot.state == kEmpty) {
+                return false;
+            }
+            if (slot.state == kFull && std::memcmp(slot.key, key, 16) == 0) {
+                slot.state = kTombstone;
+                --size_;
+                return true;
+            }
+        }
+    }
+
+    void clear() {
+        slots_.clear();
+        size_ = 0;
+        used_ = 0;
+    }
+
+    std::size_t size() const { return size_; }
+
+private:
+    static constexpr std::uint8_t kEmpty = 0;
+    static constexpr std::uint8_t kFull = 1;
+    static constexpr std::uint8_t kTombstone = 2;
+
+    struct Slot {
+        unsigned char key[16];
+        std::int32_t value;
+        std::uint8_t state;
+    };
+
+    void rehash(std::size_t min_capacity) {
+        std::size_t capacity = 16;
+        while (capacity * 3 < min_capacity * 4) {
+            capacity *= 2;
+        }
+        std::vector<Slot> old;
+        old.swap(slots_);
+        slots_.assign(capacity, Slot{{0}, 0, kEmpty});
+        size_ = 0;
+        used_ = 0;
+        for (const Slot& slot : old) {
+            if (slot.state == kFull) {
+                insert(slot.key, slot.value);
+            }
+        }
+    }
+
+    std::vector<Slot> slots_;
+    std::size_t size_ = 0;  // full slots
+    std::size_t used_ = 0;  // full + tombstone slots
+};
+
+class CsrLists {
+public:
+    void ensure_rows(std::size_t rows) {
+        if (offset_.size() < rows) {
+            offset_.resize(rows, 0);
+            size_.resize(rows, 0);
+            capacity_.resize(rows, 0);
+        }
+    }
+
+    std::uint32_t row_size(std::size_t row) const { return row < size_.size() ? size_[row] : 0; }
+
+    const std::int32_t* row_data(std::size_t row) const { return pool_.data() + offset_[row]; }
+
+    void assign(std::size_t row, const std::int32_t* values, std::size_t count) {
+        ensure_rows(row + 1);
+        if (count > capacity_[row]) {
+            relocate(row, count);
+        }
+        if (count) {
+            std::memcpy(pool_.data() + offset_[row], values, count * sizeof(std::int32_t));
+        }
+        size_[row] = static_cast<std::uint32_t>(count);
+    }
+
+    void append(std::size_t row, std::int32_t value) {
+        ensure_rows(row + 1);
+        if (size_[row] == capacity_[row]) {
+            relocate(row, size_[row] * 2 + 1);
+        }
+        pool_[offset_[row] + size_[row]++] = value;
+    }
+
+    bool remove(std::size_t row, std::int32_t value) {
+        if (row >= size_.size()) {
+            return false;
+        }
+        std::int32_t* data = pool_.data() + offset_[row];
+        for (std::uint32_t i = 0; i < size_[row]; ++i) {
+            if (data[i] == value) {
+                data[i] = data[--size_[row]];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void clear_row(std::size_t row) {
+        if (row < size_.size()) {
+            size_[row] = 0;
+        }
+    }
+
+    void clear() {
+        offset_.clear();
+        size_.clear();
+        capacity_.clear();
+        pool_.clear();
+        dead_ = 0;
+    }
+
+private:
+    // Move a row to the end of the pool with room for capacity values.
+    void relocate(std::size_t row, std::size_t capacity) {
+        if (dead_ > pool_.size() / 2 && pool_.size() > 1024) {
+            compact();
+        }
+        std::size_t new_offset = pool_.size();
+        pool_.resize(new_offset + capacity);
+        std::memcpy(pool_.data() + new_offset, pool_.data() + offset_[row], size_[row] * sizeof(std::int32_t));
+        dead_ += capacity_[row];
+        offset_[row] = static_cast<std::uint32_t>(new_offset);
+        capacity_[row] = static_cast<std::uint32_t>(capacity);
+    }
+
+    void compact() {
+        std::vector<std::int32_t> packed;
+        packed.reserve(pool_.size() - dead_);
+        for (std::size_t row = 0; row < offset_.size(); ++row) {
+            std::size_t new_offset = packed.size();
+            packed.insert(packed.end(), pool_.begin() + offset_[row], pool_.begin() + offset_[row] + size_[row]);
+            offset_[row] = static_cast<std::uint32_t>(new_offset);
+            capacity_[row] = size_[row];
+        }
+        pool_.swap(packed);
+        dead_ = 0;
+    }
+
+    std::vector<std::uint32_t> offset_;
+    std::vector<std::uint32_t> size_;
+    std::vector<std::uint32_t> capacity_;
+    std::vector<std::int32_t> pool_;
+    std::size_t dead_ = 0;
+};
+
+}  // namespace pivot_bridge
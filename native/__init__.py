@@ -20,10 +20,13 @@ __version__ = "1.0.0"
 try:
     from . import edition_utils
     from . import engine_state
+    from . import job_queue
     from . import classification
     from . import collection_manager
     
+    from . import profiler
     from . import id_manager
+    from . import transform_utils
     from . import selection_utils
     from . import shm_utils
     
@@ -42,9 +45,12 @@ __all__ = [
     "edition_utils",
     "engine_state",
     "id_manager",
+    "job_queue",
+    "profiler",
     "selection_utils",
     "shm_utils",
     "standardize",
     "surface_manager",
     "timer_manager",
+    "transform_utils",
 ]
@@ -153,6 +153,8 @@ def register():
         bpy.app.handlers.load_pre.append(handlers.on_load_pre)
     if handlers.on_load_post not in bpy.app.handlers.load_post:
         bpy.app.handlers.load_post.append(handlers.on_load_post)
+    if handlers.on_depsgraph_update_group_index not in bpy.app.handlers.depsgraph_update_post:
+        bpy.app.handlers.depsgraph_update_post.append(handlers.on_depsgraph_update_group_index)
     
     # Only register depsgraph update handler for Pro edition
     if is_pro:
@@ -180,6 +182,8 @@ def unregister():
         bpy.app.handlers.load_pre.remove(handlers.on_load_pre)
     if handlers.on_load_post in bpy.app.handlers.load_post:
         bpy.app.handlers.load_post.remove(handlers.on_load_post)
+    if handlers.on_depsgraph_update_group_index in bpy.app.handlers.depsgraph_update_post:
+        bpy.app.handlers.depsgraph_update_post.remove(handlers.on_depsgraph_update_group_index)
     # Only remove depsgraph update handler if it's registered (was only added for Pro edition)
     if handlers.on_depsgraph_update in bpy.app.handlers.depsgraph_update_post:
         bpy.app.handlers.depsgraph_update_post.remove(handlers.on_depsgraph_update)
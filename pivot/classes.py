@@ -17,7 +17,7 @@
 
 # type: ignore
 from bpy.types import PropertyGroup, Collection
-from bpy.props import BoolProperty, EnumProperty, StringProperty, PointerProperty
+from bpy.props import BoolProperty, EnumProperty, IntProperty, StringProperty, PointerProperty
 import bpy
 
 # Import C enum values from Cython module
@@ -30,6 +30,7 @@ LABEL_ROOM_COLLECTION = "Room:"
 LABEL_SURFACE_TYPE = "Surface Context:"
 LABEL_SURFACE_CONTEXT = "Surface Context:"
 LABEL_ORIGIN_METHOD = "Origin Method:"
+LABEL_PROXY_VERTEX_BUDGET = "Proxy Vertex Budget:"
 LABEL_LICENSE_TYPE = "License:"
 
 # Marker property to identify classification collections
@@ -100,3 +101,10 @@ class SceneAttributes(PropertyGroup):
         ],
         default='BASE',
     )
+    proxy_vertex_budget: IntProperty(
+        name=LABEL_PROXY_VERTEX_BUDGET.rstrip(":"),
+        description="Objects with more vertices than this are sent to the engine as a simplified proxy of at most this many vertices, which makes very dense scans much faster to process. 0 always sends the full mesh",
+        default=0,
+        min=0,
+        soft_max=1000000,
+    )
@@ -15,7 +15,7 @@
 # You should have received a copy of the GNU General Public License
 # along with this program; if not, see <https://www.gnu.org/licenses>.
 
-from pivot_lib.surface_manager import CLASSIFICATION_ROOT_MARKER_PROP
+from pivot_lib import selection_utils
 
 def selected_has_qualifying_objects(selected_objects):
     if not selected_objects:
@@ -29,35 +29,23 @@ def get_qualifying_objects_for_selected(selected_objects):
 
     return [obj for obj in selected_objects if obj.type == 'MESH']
 
+# Both group queries are called from operator poll and panel draw, so they go
+# through the shared group index in selection_utils: cost follows the
+# selection, and the index is invalidated on depsgraph collection updates.
+
 def selected_has_qualifying_groups(selected_objects, objects_collection):
     if not selected_objects or not objects_collection:
         return False
 
-    marker = CLASSIFICATION_ROOT_MARKER_PROP
-    sel_set = set(selected_objects)
-    
-    all_meshes = {o for o in objects_collection.all_objects if o.type == 'MESH'}
-    if not all_meshes: return False
-
-    for col in objects_collection.children:
-        if col.get(marker): #Skip collections that pivot uses for classification bookkeeping
-            continue
-
-        members = set(col.all_objects)
-
-        #Add object groups that include at least one selected object and at least one mesh
-        if not members.isdisjoint(sel_set):
-            if not members.isdisjoint(all_meshes):
-                return True
-
+    collections, roots = selection_utils.find_object_groups(list(selected_objects), objects_collection)
 
-    for root_obj in objects_collection.objects:
-        members = set(root_obj.children_recursive)
-        members.add(root_obj)
-
-        if not members.isdisjoint(sel_set):
-            if not members.isdisjoint(all_meshes):
-                return True
+    #A group qualifies if it includes at least one selected object and at least one mesh
+    for group in collections:
+        if selection_utils.group_has_mesh(group):
+            return True
+    for root_obj in roots:
+        if selection_utils.group_has_mesh(root_obj):
+            return True
 
     return False
 
@@ -66,33 +54,18 @@ def get_qualifying_groups_for_selected(selected_objects, objects_collection):
     if not selected_objects or not objects_collection:
         return []
 
-    marker = CLASSIFICATION_ROOT_MARKER_PROP
-    sel_set = set(selected_objects)
-    
-    all_meshes = {o for o in objects_collection.all_objects if o.type == 'MESH'}
-    if not all_meshes: return []
+    collections, roots = selection_utils.find_object_groups(list(selected_objects), objects_collection)
 
     qualifying  = []
     update_qualifying = qualifying.extend
 
-    for col in objects_collection.children:
-        if col.get(marker): #Skip collections that pivot uses for classification bookkeeping
-            continue
-
-        members = set(col.all_objects)
-
-        #Add object groups that include at least one selected object and at least one mesh
-        if not members.isdisjoint(sel_set):
-            if not members.isdisjoint(all_meshes):
-                update_qualifying(members)
-
-
-    for root_obj in objects_collection.objects:
-        members = set(root_obj.children_recursive)
-        members.add(root_obj)
+    for col in collections:
+        if selection_utils.group_has_mesh(col):
+            update_qualifying(col.all_objects)
 
-        if not members.isdisjoint(sel_set):
-            if not members.isdisjoint(all_meshes):
-                update_qualifying(members)
+    for root_obj in roots:
+        if selection_utils.group_has_mesh(root_obj):
+            update_qualifying(root_obj.children_recursive)
+            qualifying.append(root_obj)
 
-    return qualifying
\ No newline at end of file
+    return qualifying
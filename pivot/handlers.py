@@ -24,108 +24,214 @@
 import bpy
 from bpy.app.handlers import persistent
 
-from .mesh_sync import sync_timer_callback
-from pivot_lib import engine_state
+from .mesh_sync import sync_timer_callback, reset_pending_sync
+from pivot_lib import engine_state, job_queue
 import elbo_sdk_rust as engine
 from pivot_lib import surface_manager
 from pivot_lib import id_manager
+from pivot_lib import selection_utils
+from pivot_lib import transform_utils
 import time
 
-# Cache of each object's last-known world matrix (by UUID) to detect transform changes.
-_previous_world_matrices: dict[str, list[list[float]]] = {}  # keyed by obj_uuid
+# Each object's last-known world matrix, packed in Cython, to detect transform changes.
+_previous_world_matrices = transform_utils.TransformCache()
+
+# Coalescing: the handler only records what changed; the work runs once per idle
+# tick, and not at all while a modal operator (grab, rotate, ...) is running.
+COALESCE_INTERVAL = 0.05
+_dirty_collections = {}  # session_uid -> collection
+_dirty_objects = {}      # session_uid -> [object, geometry_changed]
+_scene_changed = False   # a Scene update (the master collection is embedded in it)
 
 
 @persistent
 def on_depsgraph_update(scene, depsgraph):
     """Orchestrate all depsgraph update handlers in guaranteed order."""
-    start_time = time.time()
     if engine_state.is_performing_classification():
         engine_state.set_performing_classification(False)
-    else:
-        detect_collection_hierarchy_changes(scene, depsgraph)
-        unsync_mesh_changes(scene, depsgraph)
-    end_time = time.time()
-    print(f"on_depsgraph_update took {1000 * (end_time - start_time):.4f} milliseconds")
+        return
 
+    _record_depsgraph_changes(depsgraph)
+    if (_dirty_collections or _dirty_objects or _scene_changed) and not bpy.app.timers.is_registered(_flush_timer_callback):
+        bpy.app.timers.register(_flush_timer_callback, first_interval=COALESCE_INTERVAL)
 
-def detect_collection_hierarchy_changes(scene, depsgraph):
-    """Detect changes in collection hierarchy and mark affected groups as out-of-sync with the engine."""
 
-    # Filter for collection changes
-    hierarchy_changed = False
+@persistent
+def on_depsgraph_update_group_index(scene, depsgraph):
+    """Drop the selection group index when any collection changed (registered in every edition)."""
     for update in depsgraph.updates:
         if type(update.id) is bpy.types.Collection:
-            hierarchy_changed = True
-            break
+            selection_utils.invalidate_group_index()
+            return
+
+
+def _record_depsgraph_changes(depsgraph):
+    """Fold one depsgraph update into the dirty sets."""
+    global _scene_changed
+    for update in depsgraph.updates:
+        id_block = update.id
+        if type(id_block) is bpy.types.Scene:
+            _scene_changed = True
+        elif type(id_block) is bpy.types.Collection:
+            col = id_block.original
+            _dirty_collections[col.session_uid] = col
+        elif type(id_block) is bpy.types.Object and (update.is_updated_geometry or update.is_updated_transform):
+            obj = id_block.original
+            entry = _dirty_objects.get(obj.session_uid)
+            if entry is None:
+                _dirty_objects[obj.session_uid] = [obj, update.is_updated_geometry]
+            elif update.is_updated_geometry:
+                entry[1] = True
+
+
+def _modal_operator_running():
+    wm = bpy.context.window_manager
+    if wm is None:
+        return False
+    for window in wm.windows:
+        # Window.modal_operators exists from Blender 4.2
+        if getattr(window, "modal_operators", None):
+            return True
+    return False
+
+
+def _flush_timer_callback():
+    if _modal_operator_running():
+        return COALESCE_INTERVAL
+    flush_depsgraph_changes()
+    return None
+
+
+def _id_alive(id_block):
+    """Whether a recorded ID still exists; removed IDs raise on any access."""
+    try:
+        id_block.session_uid
+    except ReferenceError:
+        return False
+    return True
 
-    if not hierarchy_changed:
+
+def flush_depsgraph_changes():
+    """Process every recorded change in one batch."""
+    global _scene_changed
+    if not (_dirty_collections or _dirty_objects or _scene_changed):
+        return
+
+    start_time = time.perf_counter()
+    # IDs deleted since they were recorded are skipped one by one
+    touched = [col for col in _dirty_collections.values() if _id_alive(col)]
+    changed = []
+    for session_uid, entry in _dirty_objects.items():
+        if _id_alive(entry[0]):
+            changed.append(entry)
+        else:
+            _previous_world_matrices.forget(session_uid)
+    scene_changed = _scene_changed
+    _dirty_collections.clear()
+    _dirty_objects.clear()
+    _scene_changed = False
+
+    detect_collection_hierarchy_changes(touched, scene_changed)
+    unsync_mesh_changes(changed)
+
+    end_time = time.perf_counter()
+    print(f"[Pivot] Processed {len(touched)} collection and {len(changed)} object updates in {1000 * (end_time - start_time):.2f} ms")
+
+
+def discard_depsgraph_changes():
+    """Forget recorded changes, e.g. before a new file is loaded."""
+    global _scene_changed
+    _dirty_collections.clear()
+    _dirty_objects.clear()
+    _scene_changed = False
+    if bpy.app.timers.is_registered(_flush_timer_callback):
+        bpy.app.timers.unregister(_flush_timer_callback)
+
+
+def detect_collection_hierarchy_changes(touched, scene_changed=False):
+    """Detect changes in collection hierarchy and mark affected groups as out-of-sync with the engine.
+
+    Only assets whose collection tree was touched (touched: original
+    collections named in depsgraph updates) are re-diffed against their
+    cached membership. Dropped assets are looked for when the objects
+    collection was touched or, since the default one is the scene's embedded
+    master collection, when the scene itself was updated.
+    """
+
+    if not touched and not scene_changed:
         return
 
+    # Edits inside the classification tree make the cached bucket layout stale
+    if any(surface_manager.is_classification_collection(col) or surface_manager.is_classification_root_collection(col) for col in touched):
+        surface_manager.invalidate_surface_cache()
+
     scene_col = id_manager.get_objects_collection()
 
-    expected_asset_uuids = set(id_manager.get_all_asset_uuids())
+    # Assets are the objects collection's children, so drops show up as an update on it
+    if scene_changed or any(col == scene_col for col in touched):
+        expected_asset_uuids = set(id_manager.get_all_asset_uuids())
+        cur_asset_uuids = set(u.get(id_manager.PIVOT_ASSET_ID) for u in scene_col.children if u.get(id_manager.PIVOT_ASSET_ID))
 
-    cur_asset_uuids = set(u.get(id_manager.PIVOT_ASSET_ID) for u in scene_col.children if u.get(id_manager.PIVOT_ASSET_ID))
+        dropped_assets = list(expected_asset_uuids.difference(cur_asset_uuids))
+        if dropped_assets:
+            for session_uid in id_manager.drop_assets(dropped_assets):
+                _previous_world_matrices.forget(session_uid)
+            engine.drop_groups_command(dropped_assets)
+            print(f"[Pivot] Dropped {dropped_assets} from engine")
 
     MESH_TYPE = "MESH"
 
-    dropped_assets = list(expected_asset_uuids.difference(cur_asset_uuids))
-    if dropped_assets:
-        id_manager.drop_assets(dropped_assets)
-        engine.drop_groups_command(dropped_assets)
-        print(f"[Pivot] Dropped {dropped_assets} from engine")
+    for asset_col in selection_utils.find_collection_groups(touched, scene_col):
+        asset_uuid = asset_col.get(id_manager.PIVOT_ASSET_ID)
+        if asset_uuid is None or not id_manager.has_asset(asset_uuid) or not id_manager.is_synced(asset_uuid):
+            continue
+
+        objs = set(id_manager.get_obj_by_uuid(id_manager.get_asset_members(asset_uuid)))
+        cur_objs = {o for o in asset_col.all_objects if o.type == MESH_TYPE}
 
-    for asset_uuid in id_manager.get_all_asset_uuids():
-        uuids = id_manager.get_asset_members(asset_uuid)
-        objs = set(id_manager.get_obj_by_uuid(uuids))
-        cur_objs = {o for o in id_manager.get_asset_by_uuid([asset_uuid])[0].all_objects if o.type == MESH_TYPE}
+        if objs != cur_objs:
+            id_manager.set_sync(asset_uuid, False)
 
-        synced = objs != cur_objs
-        if not synced:
-            id_manager.set_sync(asset_uuid, synced)
+def unsync_mesh_changes(changed):
+    """Mark groups of changed objects as unsynced.
 
-def unsync_mesh_changes(scene, depsgraph):
-    """Detect mesh and transform changes on selected objects and mark groups as unsynced."""
-    global _previous_world_matrices
+    changed holds [original object, geometry_changed] entries, one per object.
+    Geometry changes bump the object's revision and unsync its groups whether or
+    not it is selected; transform changes are only tracked for selected objects.
+    """
     
+    if not changed:
+        return
+
+    edited_uuids = [bytes(u) for u in (obj.get(id_manager.PIVOT_OBJECT_ID) for obj, geometry_changed in changed if geometry_changed) if u]
+    edited_uuids = [u for u in edited_uuids if id_manager.has_obj(u)]
+    if edited_uuids:
+        id_manager.bump_obj_revisions(edited_uuids)
+        for obj_uuid in edited_uuids:
+            for uuid in id_manager.get_obj_asset(obj_uuid):
+                id_manager.set_sync(uuid, False)
+
     if not bpy.context.selected_objects:
         return  # No selected objects, nothing to do
     
-    selected_uuids = {o.get(id_manager.PIVOT_OBJECT_ID) for o in bpy.context.selected_objects if o.get(id_manager.PIVOT_OBJECT_ID)}
-    selected_objects = selected_uuids.intersection(set(id_manager.get_all_obj_uuids()))
+    selected_uuids = {u for u in (o.get(id_manager.PIVOT_OBJECT_ID) for o in bpy.context.selected_objects) if u and id_manager.has_obj(bytes(u))}
     
-    if not selected_objects:
+    if not selected_uuids:
         return  # No selected objects in managed collections
 
-    # Main processing loop
-    for update in depsgraph.updates:
-        if not (update.is_updated_geometry or update.is_updated_transform):
-            continue
-
-        obj = update.id.original
+    for obj, geometry_changed in changed:
         obj_uuid = obj.get(id_manager.PIVOT_OBJECT_ID)
 
         if not obj_uuid in selected_uuids:
             continue
 
-        asset_uuids = id_manager.get_obj_asset(obj_uuid)
-        for uuid in asset_uuids:
-            # Convert world matrix to tuple for comparison
-            current_world_matrix = [list(col) for col in zip(*obj.matrix_world)]
-            prev_world_matrix = _previous_world_matrices.get(obj_uuid)
-            transform_changed = prev_world_matrix is not None and current_world_matrix != prev_world_matrix
-
-            should_mark_unsynced = update.is_updated_geometry or transform_changed
-
-            if should_mark_unsynced:
-                id_manager.set_sync(uuid, not should_mark_unsynced)
-
-        # Update world matrix cache for next handler invocation
-        _previous_world_matrices[obj_uuid] = current_world_matrix
+        # Always refresh the cache so the next flush compares against this matrix
+        if _previous_world_matrices.update(obj) and not geometry_changed:
+            for uuid in id_manager.get_obj_asset(obj_uuid):
+                id_manager.set_sync(uuid, False)
 
 def clear_previous_scales():
     """Clear the world matrix cache used for detecting transform changes."""
-    global _previous_world_matrices
     _previous_world_matrices.clear()
 
 
@@ -141,16 +247,19 @@ def on_load_pre(scene):
     """
     try:
         # Sync any pending group classifications to the engine before shutting down
-        surface_mgr = surface_manager.get_surface_manager()
-        classifications = surface_mgr.collect_group_classifications()
+        classifications = surface_manager.collect_group_classifications()
         if classifications:
-            surface_mgr.sync_group_classifications(classifications)
+            surface_manager.sync_group_classifications(classifications)
     except Exception as e:
         print(f"[Pivot] Failed to sync classifications before load: {e}")
 
     print("[Pivot] Unregistering sync timer callback")
     if bpy.app.timers.is_registered(sync_timer_callback):
         bpy.app.timers.unregister(sync_timer_callback)
+    reset_pending_sync()
+    discard_depsgraph_changes()
+    # Let a finalize already inside the engine return before it goes away
+    job_queue.cancel_all(wait=True)
     # Stop the pivot engine
     engine.stop_engine()
 
@@ -163,10 +272,13 @@ def on_load_post(scene):
     # Reset GroupManager state for the new scene
     # group_manager.get_group_manager().reset_state()
     id_manager.reset_state()
+    selection_utils.invalidate_group_index()
+    surface_manager.invalidate_surface_cache()
     
     # Initialize engine state for the new scene
     # engine_state.update_group_membership_snapshot({}, replace=True)
     clear_previous_scales()
+    engine_state.clear_pending_sync()
 
     engine.start_engine()
     print("[Pivot] Registering sync timer callback")
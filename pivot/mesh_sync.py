@@ -1,71 +1,175 @@
 import bpy
-import mathutils
 import elbo_sdk_rust as engine
 import time
 import numpy as np
 
 # Import our UUID manager that provides both forward and reverse caching
-from pivot_lib import id_manager, surface_manager
+from pivot_lib import id_manager, surface_manager, engine_state, job_queue
 
-MAX_NAME_LEN = 64  # keep in sync with pivot_com_types::MAX_NAME_LEN
-temp_mat = mathutils.Matrix()
 
-def sync_timer_callback():
-    sync_context = engine.poll_mesh_sync()
+# Time budget per timer tick for applying results; 0 applies a whole context at once
+_apply_budget_ms = 8.0
+# Delay before resuming a partially applied context (lets the viewport redraw)
+SYNC_RESUME_INTERVAL = 0.001
+
+# Polling cadence: fast while a finalize is outstanding, backing off exponentially when idle
+SYNC_POLL_MIN_INTERVAL = 0.01
+SYNC_POLL_MAX_INTERVAL = 0.5
+_idle_interval = SYNC_POLL_MIN_INTERVAL
+
+
+def _uuid_view(buffer):
+    """uint8[N, 16] view over a uuid buffer from the sync context, without copying."""
+    return np.frombuffer(buffer, dtype=np.uint8).reshape(-1, 16)
+
+
+class _PendingSync:
+    """Cursor into a sync context whose groups are being applied across timer ticks."""
+
+    def __init__(self, sync_context):
+        self.context = sync_context
+        self.size = sync_context.size()
+        self.next_group = 0
+        self.moved = 0
+        self.apply_ms = 0.0
+        self.asset_uuids = _uuid_view(sync_context.uuids())
+        self.job = job_queue.claim_job([uuid.tobytes() for uuid in self.asset_uuids]) if self.size else None
+
 
-    if sync_context is None:
-        return 0.01
-    
-    uuid_dt = np.dtype([('bytes', 'u1', 16)])
+_pending = None
 
-    asset_uuids = np.frombuffer(sync_context.uuids(), dtype=uuid_dt)
 
-    id_manager.set_sync_batch(asset_uuids['bytes'], True)
+def set_apply_budget_ms(budget_ms):
+    """Set the per-tick budget for applying engine results (0 disables time slicing)."""
+    global _apply_budget_ms
+    _apply_budget_ms = max(0.0, float(budget_ms))
+
+
+def get_apply_budget_ms():
+    return _apply_budget_ms
+
+
+def reset_pending_sync():
+    """Drop a partially applied sync context, e.g. before a new file is loaded."""
+    global _pending
+    if _pending is not None:
+        if _pending.size > 1:
+            _end_progress()
+        if _pending.job is not None:
+            # Only part of its results were applied
+            _pending.job.cancel()
+            job_queue.finish_job(_pending.job)
+    _pending = None
+
+
+def _begin_sync(sync_context):
+    pending = _PendingSync(sync_context)
+
+    if pending.job is not None and pending.job.is_stale():
+        print(f"[Pivot] Discarding results of a cancelled job ({pending.size} assets)")
+        job_queue.finish_job(pending.job)
+        return None
 
     asset_surface_contexts = np.frombuffer(sync_context.surface_contexts(), dtype=np.uint16)
+    surface_manager.organize_groups_into_surfaces(pending.asset_uuids, asset_surface_contexts)
 
-    surface_manager.organize_groups_into_surfaces(asset_uuids['bytes'], asset_surface_contexts)
+    if pending.size > 1:
+        wm = bpy.context.window_manager
+        if wm is not None:
+            wm.progress_begin(0, pending.size)
+    return pending
 
-    start = time.perf_counter()
-    for group_index in range(sync_context.size()):
-        (verts, edges, loops, loop_bases, object_loop_counts, transforms, vert_counts, edge_counts, object_names, uuids) = sync_context.buffers(group_index)
-        
-
-        obj_uuids = np.frombuffer(uuids, dtype=uuid_dt)
-        
-        id_manager.set_asset_membership(asset_uuids['bytes'][group_index].tobytes(), obj_uuids['bytes'])
-
-        object_count = len(object_names) //MAX_NAME_LEN
-        for obj_index in range(object_count):
-            
-            obj_uuid = obj_uuids['bytes'][obj_index].tobytes()
-
-            # Use O(1) lookup for the Blender object instead of string parsing
-            # The objects should already be cached via get_or_create_obj_uuid in shm_utils.pyx
-            obj = id_manager.get_obj_by_uuid([obj_uuid])[0]
-            if obj is not None:
-                transform_start = obj_index * 16 * 4
-                transform_end = transform_start + 16 * 4
-                # 1. Cast the flat view into a 2D 4x4 shape
-                # This creates a 'view' of the data as 4 rows of 4 floats
-                # 1. Keep the view FLAT
-                mat_view = transforms[transform_start:transform_end].cast("f")
-
-                # 2. Use a simple generator or zip to chunk it into rows of 4
-                # This is much faster than .tolist() because it doesn't create 16 float objects upfront
-                it = iter(mat_view)
-                mat = mathutils.Matrix(list(zip(it, it, it, it)))
-
-                # 3. Apply
-                obj.matrix_world = mat.transposed()
-                obj.data.update()
-                obj.update_tag()
-    end = time.perf_counter()
-    print(f"[Pivot] Applied sync for {sync_context.size()} assets in {(end - start) * 1000:.2f} ms")
 
+def _end_progress():
+    wm = bpy.context.window_manager
+    if wm is not None:
+        wm.progress_end()
+
+
+def _apply_slice(pending, budget_ms):
+    """Apply groups until the budget is spent. Returns True once the context is done."""
     start = time.perf_counter()
-    # bpy.context.view_layer.update()
-    end = time.perf_counter()
-    print(f"[Pivot] Depsgraph update took {(end - start) * 1000:.2f} ms")
+    deadline = start + budget_ms / 1000.0 if budget_ms > 0 else None
+    moved_before = pending.moved
+
+    while pending.next_group < pending.size:
+        group_index = pending.next_group
+        (verts, edges, loops, loop_bases, object_loop_counts, transforms, vert_counts, edge_counts, object_names, uuids) = pending.context.buffers(group_index)
+
+        pending.moved += id_manager.apply_group_sync(pending.asset_uuids, group_index, _uuid_view(uuids), memoryview(transforms).cast("f"))
+
+        pending.next_group += 1
+        if pending.job is not None:
+            pending.job.applied_groups = pending.next_group
+        if deadline is not None and time.perf_counter() >= deadline:
+            break
+
+    pending.apply_ms += (time.perf_counter() - start) * 1000
+
+    # Our own matrix writes are not user edits; keep the depsgraph handler from unsyncing them
+    if pending.moved > moved_before:
+        engine_state.set_performing_classification(True)
+
+    if pending.size > 1:
+        wm = bpy.context.window_manager
+        if wm is not None:
+            wm.progress_update(pending.next_group)
 
-    return 0
\ No newline at end of file
+    return pending.next_group >= pending.size
+
+
+def _next_poll_interval():
+    """Interval until the next poll when the engine had nothing for us."""
+    global _idle_interval
+    if engine_state.has_pending_sync():
+        _idle_interval = SYNC_POLL_MIN_INTERVAL
+        return SYNC_POLL_MIN_INTERVAL
+    interval = _idle_interval
+    _idle_interval = min(_idle_interval * 2.0, SYNC_POLL_MAX_INTERVAL)
+    return interval
+
+
+def wake_sync_timer():
+    """Poll again right away, e.g. after submitting work while the timer is backed off."""
+    global _idle_interval
+    _idle_interval = SYNC_POLL_MIN_INTERVAL
+    if bpy.app.timers.is_registered(sync_timer_callback):
+        bpy.app.timers.unregister(sync_timer_callback)
+        bpy.app.timers.register(sync_timer_callback, first_interval=0.0)
+
+
+def sync_timer_callback():
+    global _pending, _idle_interval
+
+    if _pending is None:
+        sync_context = engine.poll_mesh_sync()
+
+        if sync_context is None:
+            return _next_poll_interval()
+
+        engine_state.end_pending_sync()
+        _idle_interval = SYNC_POLL_MIN_INTERVAL
+        _pending = _begin_sync(sync_context)
+        if _pending is None:
+            return 0
+
+    if _pending.job is not None and _pending.job.is_stale():
+        # Cancelled (or outlived by a cancel_all) mid-apply; leave the rest of its groups alone
+        print(f"[Pivot] Stopped applying a cancelled job at {_pending.next_group}/{_pending.size} assets")
+        if _pending.size > 1:
+            _end_progress()
+        job_queue.finish_job(_pending.job)
+        _pending = None
+        return 0
+
+    if not _apply_slice(_pending, _apply_budget_ms):
+        return SYNC_RESUME_INTERVAL
+
+    if _pending.size > 1:
+        _end_progress()
+    if _pending.job is not None:
+        job_queue.finish_job(_pending.job)
+    print(f"[Pivot] Applied sync for {_pending.size} assets ({_pending.moved} objects moved) in {_pending.apply_ms:.2f} ms")
+    _pending = None
+
+    return 0
@@ -23,6 +23,8 @@ from pivot_lib import standardize
 from pivot_lib import id_manager
 from pivot_lib import engine_state
 from ..classification_utils import get_qualifying_groups_for_selected, selected_has_qualifying_groups
+from ..mesh_sync import wake_sync_timer
+from ..handlers import flush_depsgraph_changes
 
 
 class Pivot_OT_Standardize_Selected_Groups(bpy.types.Operator):
@@ -49,6 +51,9 @@ class Pivot_OT_Standardize_Selected_Groups(bpy.types.Operator):
         # Exit edit mode if active to ensure mesh data is accessible
         if bpy.context.mode == 'EDIT_MESH':
             bpy.ops.object.mode_set(mode='OBJECT')
+        # Edits still buffered by the depsgraph handler must bump revisions
+        # before the dirty check decides which groups are current
+        flush_depsgraph_changes()
         
         startTime = time.perf_counter()
         
@@ -57,11 +62,13 @@ class Pivot_OT_Standardize_Selected_Groups(bpy.types.Operator):
         origin_method = context.scene.pivot.origin_method
         surface_type = context.scene.pivot.surface_type
         
-        standardize.standardize_groups(
+        standardize.submit_standardize_groups(
             objects, 
             origin_method=origin_method, 
-            surface_context=surface_type
+            surface_context=surface_type,
+            proxy_vertex_budget=context.scene.pivot.proxy_vertex_budget,
         )
+        wake_sync_timer()
         
         endTime = time.perf_counter()
         elapsed = endTime - startTime
@@ -23,6 +23,8 @@ from pivot_lib import standardize
 from ..classification_utils import get_qualifying_objects_for_selected, selected_has_qualifying_objects
 from pivot_lib import edition_utils
 from pivot_lib import timer_manager
+from ..mesh_sync import wake_sync_timer
+from ..handlers import flush_depsgraph_changes
 
 # Operator descriptions
 DESC_SET_ORIGIN_SELECTED = "Applies the configured 'Origin Method' to each selected object, respecting the chosen 'Surface Context'. Use this to fix only the origins without affecting rotation"
@@ -60,16 +62,19 @@ class Pivot_OT_Set_Origin_Selected_Objects(bpy.types.Operator):
         # Exit edit mode if active to ensure mesh data is accessible
         if bpy.context.mode == 'EDIT_MESH':
             bpy.ops.object.mode_set(mode='OBJECT')
+        flush_depsgraph_changes()
         print("set_origin_selected_objects.get_qualifying: ", timer_manager.timers.stop("set_origin_selected_objects.get_qualifying"), "ms")
         timer_manager.timers.reset("set_origin_selected_objects.get_qualifying")
         
         origin_method = context.scene.pivot.origin_method
         surface_type = context.scene.pivot.surface_type
+        proxy_vertex_budget = context.scene.pivot.proxy_vertex_budget
         if edition_utils.is_standard_edition() and len(objects) > 1:
             for obj in objects:
-                standardize.standardize_object_origins([obj], origin_method=origin_method, surface_context=surface_type)
+                standardize.submit_standardize_object_origins([obj], origin_method=origin_method, surface_context=surface_type, proxy_vertex_budget=proxy_vertex_budget)
         else:
-            standardize.standardize_object_origins(objects, origin_method=origin_method, surface_context=surface_type)
+            standardize.submit_standardize_object_origins(objects, origin_method=origin_method, surface_context=surface_type, proxy_vertex_budget=proxy_vertex_budget)
+        wake_sync_timer()
        
         print("set_origin_selected_objects.underhead: ", timer_manager.timers.stop("set_origin_selected_objects.underhead"), "ms")
         timer_manager.timers.reset("set_origin_selected_objects.underhead")
@@ -106,14 +111,17 @@ class Pivot_OT_Align_Facing_Selected_Objects(bpy.types.Operator):
         # Exit edit mode if active to ensure mesh data is accessible
         if bpy.context.mode == 'EDIT_MESH':
             bpy.ops.object.mode_set(mode='OBJECT')
+        flush_depsgraph_changes()
         
         startTime = time.perf_counter()
         
+        proxy_vertex_budget = context.scene.pivot.proxy_vertex_budget
         if edition_utils.is_standard_edition() and len(objects) > 1:
             for obj in objects:
-                standardize.standardize_object_rotations([obj])
+                standardize.submit_standardize_object_rotations([obj], proxy_vertex_budget=proxy_vertex_budget)
         else:
-            standardize.standardize_object_rotations(objects)
+            standardize.submit_standardize_object_rotations(objects, proxy_vertex_budget=proxy_vertex_budget)
+        wake_sync_timer()
         
         endTime = time.perf_counter()
         elapsed = endTime - startTime
@@ -128,6 +128,7 @@ class Pivot_OT_Reset_Classifications(bpy.types.Operator):
                     print(f"[Pivot] Failed to delete collection '{coll.name}': {e}")
                     self.report({"WARNING"}, f"Failed to delete collection: {coll.name}")
             
+            surface_manager.invalidate_surface_cache()
             if deleted_count > 0:
                 self.report({"INFO"}, f"Reset classifications: deleted {deleted_count} collection(s)")
                 engine_state.set_performing_classification(True)
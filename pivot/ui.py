@@ -30,7 +30,7 @@ from .operators.object_classification import (
 )
 
 from .constants import PRE, CATEGORY, LICENSE_PRO, LICENSE_STANDARD
-from .classes import LABEL_OBJECTS_COLLECTION, LABEL_ORIGIN_METHOD, LABEL_SURFACE_TYPE
+from .classes import LABEL_OBJECTS_COLLECTION, LABEL_ORIGIN_METHOD, LABEL_PROXY_VERTEX_BUDGET, LABEL_SURFACE_TYPE
 from pivot_lib import edition_utils
 import elbo_sdk_rust as engine
 
@@ -73,6 +73,10 @@ class Pivot_PT_Configuration_Panel(bpy.types.Panel):
         row.label(text=LABEL_ORIGIN_METHOD)
         row = layout.row()
         row.prop(bpy.context.scene.pivot, "origin_method", expand=True)
+        row = layout.row()
+        row.label(text=LABEL_PROXY_VERTEX_BUDGET)
+        row = layout.row()
+        row.prop(bpy.context.scene.pivot, "proxy_vertex_budget", text="")
 
 
 class Pivot_PT_Pro_Panel(bpy.types.Panel):
@@ -0,0 +1,130 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+"""Headless check that synced groups are skipped until a member changes.
+
+Covers submit -> apply -> resubmit: after the first upload is applied every
+group must report current and a second dirty-only submit must send nothing;
+bumping one member's revision must re-send exactly its group.
+
+Usage:
+    blender -b --factory-startup --python-exit-code 1 \
+        --python tests/test_sync_revisions.py
+
+Requires pivot_lib in Blender's site-packages and the engine binary in
+pivot/bin, as for the benchmarks. Exits with SKIP_CODE on the Standard
+edition, which cannot standardize groups.
+"""
+
+import os
+import sys
+import time
+
+import bpy
+
+REPO_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+GROUPS = 3
+OBJECTS_PER_GROUP = 2
+SYNC_TIMEOUT_S = 120.0
+SKIP_CODE = 77
+
+
+def _build_scene():
+    bpy.data.batch_remove(list(bpy.data.objects))
+    bpy.data.batch_remove(list(bpy.data.meshes))
+    bpy.data.batch_remove(list(bpy.data.collections))
+
+    scene = bpy.context.scene
+    for g in range(GROUPS):
+        col = bpy.data.collections.new(f"test_group_{g}")
+        scene.collection.children.link(col)
+        for o in range(OBJECTS_PER_GROUP):
+            mesh = bpy.data.meshes.new(f"test_mesh_{g}_{o}")
+            mesh.from_pydata([(0, 0, 0), (1, 0, 0), (1, 1, 0.5), (0, 1, 0)], [], [(0, 1, 2, 3)])
+            obj = bpy.data.objects.new(f"test_{g}_{o}", mesh)
+            obj.location = (g * 3.0, o * 3.0, 0.0)
+            col.objects.link(obj)
+
+    scene.pivot.objects_collection = None
+    bpy.context.view_layer.update()
+    for obj in bpy.data.objects:
+        obj.select_set(True)
+    return list(bpy.context.selected_objects)
+
+
+def _drain_sync(mesh_sync, jobs):
+    deadline = time.perf_counter() + SYNC_TIMEOUT_S
+    while any(not job.done() for job in jobs):
+        if time.perf_counter() > deadline:
+            raise TimeoutError("engine results did not arrive in time")
+        interval = mesh_sync.sync_timer_callback()
+        if interval:
+            time.sleep(min(interval, 0.01))
+
+
+def _submit(standardize, selection):
+    return standardize.submit_standardize_groups(selection, "BASE", "AUTO", dirty_only=True)
+
+
+def run(standardize, id_manager, mesh_sync):
+    selection = _build_scene()
+    collections = [c for c in bpy.data.collections if c.name.startswith("test_group_")]
+
+    jobs = _submit(standardize, selection)
+    assert sum(job.group_count for job in jobs) == GROUPS, "first submit must upload every group"
+    _drain_sync(mesh_sync, jobs)
+
+    asset_uuids = id_manager.get_or_create_asset_uuid(collections)
+    for col, uuid in zip(collections, asset_uuids):
+        assert id_manager.is_asset_current(uuid), f"{col.name} should be current after its results were applied"
+
+    jobs = _submit(standardize, selection)
+    assert not jobs, f"resubmit must skip synced groups, sent {sum(job.group_count for job in jobs)}"
+
+    # A geometry change on one member re-sends only its group
+    changed = collections[0].objects[0]
+    id_manager.bump_obj_revisions(id_manager.get_or_create_obj_uuids([changed]))
+    assert not id_manager.is_asset_current(asset_uuids[0])
+    jobs = _submit(standardize, selection)
+    assert sum(job.group_count for job in jobs) == 1, "only the changed group must be re-sent"
+    _drain_sync(mesh_sync, jobs)
+    assert id_manager.is_asset_current(asset_uuids[0])
+
+
+def main():
+    if REPO_ROOT not in sys.path:
+        sys.path.insert(0, REPO_ROOT)
+    import pivot
+    pivot.register()
+
+    from pivot import mesh_sync
+    from pivot_lib import edition_utils, id_manager, standardize
+
+    try:
+        if not edition_utils.is_pro_edition():
+            print("[Pivot] test_sync_revisions skipped: needs the Pro edition")
+            sys.exit(SKIP_CODE)
+        mesh_sync.set_apply_budget_ms(0)
+        run(standardize, id_manager, mesh_sync)
+        print("[Pivot] test_sync_revisions passed")
+    finally:
+        pivot.unregister()
+
+
+if __name__ == "__main__":
+    main()
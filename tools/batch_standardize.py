@@ -0,0 +1,266 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+"""Headless batch standardization of many .blend files (Pro edition).
+
+Run with a regular Python to fan files out over several Blender processes:
+    python tools/batch_standardize.py --blender /path/to/blender --jobs 8 \
+        --output-dir standardized/ library/*.blend library/props/
+
+Every worker is a background Blender that registers the addon, then for each
+of its files: opens it, streams all groups of the objects collection through
+standardize.submit_standardize_groups (the same create_data_arrays upload and
+job queue the operators use), drives the sync timer until every result is
+applied, and saves the file to --output-dir (or in place with --in-place).
+
+Files are split over workers by size so they finish at about the same time.
+Each worker writes a JSON report; the driver merges them into --report and
+exits non-zero if any file failed. Requires pivot_lib in Blender's
+site-packages and the engine binary in pivot/bin, as for the benchmarks.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+REPO_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SCRIPT_PATH = os.path.abspath(__file__)
+
+SYNC_TIMEOUT_S = 1800.0
+
+
+def _parse_args(argv):
+    parser = argparse.ArgumentParser(prog="batch_standardize.py")
+    parser.add_argument("paths", nargs="*", help=".blend files or directories to search recursively")
+    parser.add_argument("--blender", type=str, default=os.environ.get("BLENDER", "blender"), help="Blender executable (default: $BLENDER or blender on PATH)")
+    parser.add_argument("--jobs", type=int, default=max(1, (os.cpu_count() or 2) // 2), help="Blender worker processes")
+    parser.add_argument("--output-dir", type=str, help="Directory for the standardized files (relative layout is kept)")
+    parser.add_argument("--in-place", action="store_true", help="Overwrite the input files instead of writing to --output-dir")
+    parser.add_argument("--origin-method", choices=["BASE", "VOLUME"], default="BASE")
+    parser.add_argument("--surface-context", type=str, default="AUTO", help="AUTO or a surface type id")
+    parser.add_argument("--proxy-vertex-budget", type=int, default=0, help="Upload objects above this many vertices as proxies (0: full meshes)")
+    parser.add_argument("--report", type=str, help="JSON report path (default: stdout)")
+    # Internal: set by the driver when it launches a worker inside Blender
+    parser.add_argument("--worker-manifest", type=str, help=argparse.SUPPRESS)
+    return parser.parse_args(argv)
+
+
+# ---------------------------------------------------------------------------
+# Driver (plain Python)
+# ---------------------------------------------------------------------------
+
+def _collect_files(paths):
+    files = []
+    for path in paths:
+        if os.path.isdir(path):
+            for dirpath, _, names in os.walk(path):
+                files.extend(os.path.join(dirpath, n) for n in sorted(names) if n.endswith(".blend"))
+        elif path.endswith(".blend"):
+            files.append(path)
+    return [os.path.abspath(f) for f in files]
+
+
+def _output_path(src, roots, output_dir):
+    """Place src under output_dir, relative to the input root it was found in."""
+    for root in roots:
+        root = os.path.abspath(root)
+        if os.path.isdir(root) and os.path.commonpath([root, src]) == root:
+            return os.path.join(output_dir, os.path.relpath(src, root))
+    return os.path.join(output_dir, os.path.basename(src))
+
+
+def _split_by_size(files, jobs):
+    """Greedy largest-first partition so every worker gets a similar byte total."""
+    buckets = [[] for _ in range(jobs)]
+    loads = [0] * jobs
+    for path in sorted(files, key=os.path.getsize, reverse=True):
+        i = loads.index(min(loads))
+        buckets[i].append(path)
+        loads[i] += os.path.getsize(path)
+    return [b for b in buckets if b]
+
+
+def run_driver(args):
+    if not args.in_place and not args.output_dir:
+        sys.exit("batch_standardize.py: pass --output-dir or --in-place")
+
+    files = _collect_files(args.paths)
+    if not files:
+        sys.exit("batch_standardize.py: no .blend files found")
+
+    tasks = [
+        {"src": f, "dst": f if args.in_place else _output_path(f, args.paths, os.path.abspath(args.output_dir))}
+        for f in files
+    ]
+    dst_by_src = {t["src"]: t["dst"] for t in tasks}
+    buckets = _split_by_size(files, max(1, args.jobs))
+
+    settings = {
+        "origin_method": args.origin_method,
+        "surface_context": args.surface_context,
+        "proxy_vertex_budget": args.proxy_vertex_budget,
+    }
+
+    start = time.perf_counter()
+    workers = []
+    with tempfile.TemporaryDirectory(prefix="pivot_batch_") as tmp:
+        for i, bucket in enumerate(buckets):
+            manifest = os.path.join(tmp, f"worker_{i}.json")
+            report = os.path.join(tmp, f"worker_{i}_report.json")
+            with open(manifest, "w", encoding="utf-8") as f:
+                json.dump({"tasks": [{"src": s, "dst": dst_by_src[s]} for s in bucket], "settings": settings, "report": report}, f)
+            cmd = [args.blender, "-b", "--factory-startup", "--python", SCRIPT_PATH, "--", "--worker-manifest", manifest]
+            print(f"[Pivot] Worker {i}: {len(bucket)} files")
+            workers.append((subprocess.Popen(cmd), report, bucket))
+
+        results = []
+        for proc, report, bucket in workers:
+            code = proc.wait()
+            if os.path.exists(report):
+                with open(report, encoding="utf-8") as f:
+                    results.extend(json.load(f)["results"])
+            # Files a crashed worker never reported on
+            reported = {r["src"] for r in results}
+            for src in bucket:
+                if src not in reported:
+                    results.append({"src": src, "dst": dst_by_src[src], "status": "FAILED", "error": f"worker exited with code {code}"})
+
+    failed = [r for r in results if r["status"] == "FAILED"]
+    summary = {
+        "files": len(results),
+        "failed": len(failed),
+        "groups": sum(r.get("groups", 0) for r in results),
+        "workers": len(workers),
+        "wall_s": time.perf_counter() - start,
+        "settings": settings,
+        "results": sorted(results, key=lambda r: r["src"]),
+    }
+    text = json.dumps(summary, indent=2)
+    if args.report:
+        with open(args.report, "w", encoding="utf-8") as f:
+            f.write(text)
+        print(f"[Pivot] Standardized {summary['groups']} groups in {len(results)} files ({len(failed)} failed) in {summary['wall_s']:.1f} s; report: {args.report}")
+    else:
+        print(text)
+    sys.exit(1 if failed else 0)
+
+
+# ---------------------------------------------------------------------------
+# Worker (inside Blender)
+# ---------------------------------------------------------------------------
+
+def _drain_sync(mesh_sync, jobs):
+    """Drive the sync timer by hand until every job's results are applied."""
+    deadline = time.perf_counter() + SYNC_TIMEOUT_S
+    while any(not job.done() for job in jobs):
+        if time.perf_counter() > deadline:
+            raise TimeoutError("engine results did not arrive in time")
+        interval = mesh_sync.sync_timer_callback()
+        if interval:
+            time.sleep(min(interval, 0.01))
+
+
+def _standardize_file(task, settings):
+    import bpy
+    from pivot_lib import id_manager, standardize, job_queue
+    from pivot import mesh_sync
+
+    record = {"src": task["src"], "dst": task["dst"]}
+    t = time.perf_counter()
+    bpy.ops.wm.open_mainfile(filepath=task["src"], load_ui=False)
+    record["open_ms"] = (time.perf_counter() - t) * 1000
+
+    scene_coll = id_manager.get_objects_collection()
+    objects = [o for o in scene_coll.all_objects if o.type == "MESH"]
+    if not objects:
+        record.update(status="SKIPPED", groups=0)
+        return record
+
+    t = time.perf_counter()
+    jobs = standardize.submit_standardize_groups(
+        objects,
+        origin_method=settings["origin_method"],
+        surface_context=settings["surface_context"],
+        dirty_only=False,
+        proxy_vertex_budget=settings["proxy_vertex_budget"],
+    )
+    _drain_sync(mesh_sync, jobs)
+    record["standardize_ms"] = (time.perf_counter() - t) * 1000
+
+    errors = [job.error for job in jobs if job.state == job_queue.JOB_FAILED]
+    record["groups"] = sum(job.group_count for job in jobs)
+    if errors:
+        record.update(status="FAILED", error="; ".join(errors))
+        return record
+
+    os.makedirs(os.path.dirname(task["dst"]), exist_ok=True)
+    t = time.perf_counter()
+    bpy.ops.wm.save_as_mainfile(filepath=task["dst"], copy=task["dst"] != task["src"])
+    record["save_ms"] = (time.perf_counter() - t) * 1000
+    record["status"] = "DONE"
+    return record
+
+
+def run_worker(manifest_path):
+    with open(manifest_path, encoding="utf-8") as f:
+        manifest = json.load(f)
+
+    if REPO_ROOT not in sys.path:
+        sys.path.insert(0, REPO_ROOT)
+    import pivot
+    pivot.register()
+
+    from pivot import mesh_sync
+    from pivot_lib import edition_utils
+
+    results = []
+    try:
+        if not edition_utils.is_pro_edition():
+            raise RuntimeError("batch standardization needs the Pro edition")
+        # Apply whole contexts per tick; nobody is waiting on a viewport redraw
+        mesh_sync.set_apply_budget_ms(0)
+        for task in manifest["tasks"]:
+            print(f"[Pivot] Standardizing {task['src']}")
+            try:
+                results.append(_standardize_file(task, manifest["settings"]))
+            except Exception as e:
+                print(f"[Pivot] Failed on {task['src']}: {e}")
+                results.append({"src": task["src"], "dst": task["dst"], "status": "FAILED", "error": str(e)})
+    except Exception as e:
+        reported = {r["src"] for r in results}
+        results.extend({"src": t["src"], "dst": t["dst"], "status": "FAILED", "error": str(e)} for t in manifest["tasks"] if t["src"] not in reported)
+    finally:
+        with open(manifest["report"], "w", encoding="utf-8") as f:
+            json.dump({"results": results}, f)
+        pivot.unregister()
+
+
+def main():
+    argv = sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else sys.argv[1:]
+    args = _parse_args(argv)
+    if args.worker_manifest:
+        run_worker(args.worker_manifest)
+    else:
+        run_driver(args)
+
+
+if __name__ == "__main__":
+    main()